@@ -0,0 +1,77 @@
+
+#include "harness.hpp"
+
+#include <std/eytzinger.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Compares lookups into a sorted array of ints with std::lower_bound,
+// stl::lower_bound, stl::batch_lower_bound, and an eytzinger_index,
+// one key at a time and batched. Throughput is in lookups per second.
+//
+// Usage: bench_binary_search [--lookups=N] [--key=value...]
+//
+// The number of lookups defaults to 64K. See harness.hpp for the other
+// options.
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "binary_search");
+  long lookups = r.get("lookups", 1 << 16);
+
+  for (std::size_t bytes : r.sizes()) {
+    long n = bytes / sizeof(int);
+    std::vector<int> v(n);
+    for (long i = 0; i < n; ++i)
+      v[i] = 2 * i;
+    stl::eytzinger_index<int> idx(v);
+
+    std::vector<int> keys(lookups);
+    std::mt19937 gen(n);
+    for (int& k : keys)
+      k = gen() % (2 * n - 1);
+
+    auto name = [&](char const* algo) {
+      return std::string(algo) + "/" + std::to_string(n);
+    };
+    std::vector<std::vector<int>::iterator> out1(lookups);
+    std::vector<int const*> out2(lookups);
+    r.run(name("std::lower_bound"), lookups, bytes, [&]() {
+      long sum = 0;
+      for (int k : keys)
+        sum += *std::lower_bound(v.begin(), v.end(), k);
+      bench::keep(sum);
+    });
+    r.run(name("lower_bound"), lookups, bytes, [&]() {
+      long sum = 0;
+      for (int k : keys)
+        sum += *stl::lower_bound(v, k);
+      bench::keep(sum);
+    });
+    r.run(name("batch_lower_bound"), lookups, bytes, [&]() {
+      stl::batch_lower_bound(v, keys, out1.begin());
+    });
+    r.run(name("eytzinger_index::lower_bound"), lookups, bytes, [&]() {
+      long sum = 0;
+      for (int k : keys)
+        sum += *idx.lower_bound(k);
+      bench::keep(sum);
+    });
+    r.run(name("eytzinger_index::batch_lower_bound"), lookups, bytes, [&]() {
+      idx.batch_lower_bound(keys, out2.begin());
+    });
+    if (r.selected(name("batch_lower_bound")) &&
+        r.selected(name("eytzinger_index::batch_lower_bound")))
+      for (long i = 0; i < lookups; ++i)
+        if (*out1[i] != *out2[i]) {
+          std::fprintf(stderr, "error: results differ\n");
+          return 1;
+        }
+  }
+}
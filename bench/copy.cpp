@@ -0,0 +1,52 @@
+
+#include "harness.hpp"
+
+#include <std/algorithm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Measures the copy and fill family, serially and in parallel. Bytes
+// per second count the bytes written.
+//
+// Usage: bench_copy [--key=value...]
+//
+// See harness.hpp for the options.
+
+template<typename T>
+void
+run(bench::runner& r, char const* type, std::size_t bytes)
+{
+  std::size_t n = bytes / sizeof(T);
+  std::vector<T> a(n, T(1));
+  std::vector<T> b(n);
+  auto name = [&](char const* algo) {
+    return std::string(algo) + "/" + type + "/" + std::to_string(n);
+  };
+
+  auto par = stl::execution::par;
+  r.run(name("copy"), n, bytes, [&]() { stl::copy(a, b.begin()); });
+  r.run(name("copy_n"), n, bytes, [&]() { stl::copy_n(a.begin(), n, b.begin()); });
+  r.run(name("move"), n, bytes, [&]() { stl::move(a, b.begin()); });
+  r.run(name("move_backward"), n, bytes, [&]() { stl::move_backward(a, b.end()); });
+  r.run(name("fill"), n, bytes, [&]() { stl::fill(b, T(2)); });
+  r.run(name("fill_n"), n, bytes, [&]() { stl::fill_n(b.begin(), n, T(2)); });
+  r.run(name("par_copy"), n, bytes, [&]() { stl::copy(par, a, b.begin()); });
+  r.run(name("par_move"), n, bytes, [&]() { stl::move(par, a, b.begin()); });
+  r.run(name("par_fill"), n, bytes, [&]() { stl::fill(par, b, T(2)); });
+  bench::keep(b.data());
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "copy");
+  for (std::size_t bytes : r.sizes()) {
+    run<std::int8_t>(r, "int8", bytes);
+    run<std::int32_t>(r, "int32", bytes);
+    run<double>(r, "double", bytes);
+  }
+}
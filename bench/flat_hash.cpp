@@ -0,0 +1,82 @@
+
+#include "harness.hpp"
+
+#include <std/flat_hash.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Measures building and probing hash maps, against std::unordered_map.
+//
+// Maps of 64-bit keys are built with room reserved in advance, and then
+// probed with keys that are all present (hits) or all absent (misses),
+// in random order. std::unordered_map uses stl::hash too, so that the
+// difference is the table and not the hash function.
+//
+// Usage: bench_flat_hash [--key=value...]
+//
+// See harness.hpp for the options.
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "flat_hash");
+  for (std::size_t bytes : r.sizes()) {
+    using entry = std::pair<std::uint64_t, std::uint64_t>;
+    std::size_t n = bytes / sizeof(entry);
+    std::vector<std::uint64_t> keys(n);
+    std::vector<std::uint64_t> misses(n);
+    std::uint64_t x = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+      x = x * 6364136223846793005ull + 1442695040888963407ull;
+      keys[i] = x & ~1ull;
+      misses[i] = x | 1;
+    }
+    auto name = [&](char const* op) {
+      return std::string(op) + "/" + std::to_string(n);
+    };
+
+    using flat = stl::flat_hash_map<std::uint64_t, std::uint64_t>;
+    using node = std::unordered_map<std::uint64_t, std::uint64_t, stl::hash<>>;
+
+    r.run(name("build/flat_hash_map"), n, bytes, [&]() {
+      flat m;
+      m.reserve(n);
+      for (std::uint64_t k : keys)
+        m.try_emplace(k, k);
+      bench::keep(m.size());
+    });
+    r.run(name("build/unordered_map"), n, bytes, [&]() {
+      node m;
+      m.reserve(n);
+      for (std::uint64_t k : keys)
+        m.try_emplace(k, k);
+      bench::keep(m.size());
+    });
+
+    flat f;
+    node u;
+    f.reserve(n);
+    u.reserve(n);
+    for (std::uint64_t k : keys) {
+      f.try_emplace(k, k);
+      u.try_emplace(k, k);
+    }
+    auto probe = [&](auto const& m, std::vector<std::uint64_t> const& v) {
+      std::uint64_t sum = 0;
+      for (std::uint64_t k : v) {
+        auto i = m.find(k);
+        if (i != m.end())
+          sum += i->second;
+      }
+      bench::keep(sum);
+    };
+    r.run(name("hit/flat_hash_map"), n, bytes, [&]() { probe(f, keys); });
+    r.run(name("hit/unordered_map"), n, bytes, [&]() { probe(u, keys); });
+    r.run(name("miss/flat_hash_map"), n, bytes, [&]() { probe(f, misses); });
+    r.run(name("miss/unordered_map"), n, bytes, [&]() { probe(u, misses); });
+  }
+}
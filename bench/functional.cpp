@@ -0,0 +1,115 @@
+
+#include "harness.hpp"
+
+#include <std/functional.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+// Measures the cost of calling through a type-erased callback.
+//
+// A function that is not inlined calls its callback once per element,
+// through a function pointer, a function_ref, and a std::function. The
+// function pointer and function_ref should cost the same: one indirect
+// call. std::function adds a second indirection.
+//
+// Wrapping a callable that captures more than a few pointers is also
+// measured, since std::function allocates for it and function_ref does
+// not.
+//
+// Usage: bench_functional [--key=value...]
+//
+// See harness.hpp for the options.
+
+namespace
+{
+
+long f_xor(long x) { return x ^ 0x5a; }
+
+__attribute__((noinline)) long
+sum_calls(long (*f)(long), std::vector<long> const& v)
+{
+  long sum = 0;
+  for (long x : v)
+    sum += f(x);
+  return sum;
+}
+
+__attribute__((noinline)) long
+sum_calls(stl::function_ref<long(long)> f, std::vector<long> const& v)
+{
+  long sum = 0;
+  for (long x : v)
+    sum += f(x);
+  return sum;
+}
+
+__attribute__((noinline)) long
+sum_calls(std::function<long(long)> const& f, std::vector<long> const& v)
+{
+  long sum = 0;
+  for (long x : v)
+    sum += f(x);
+  return sum;
+}
+
+__attribute__((noinline)) long
+call_ref(stl::function_ref<long(long)> f)
+{
+  return f(1);
+}
+
+__attribute__((noinline)) long
+call_function(std::function<long(long)> f)
+{
+  return f(1);
+}
+
+} // namespace
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "functional");
+  for (std::size_t bytes : r.sizes()) {
+    std::ptrdiff_t n = bytes / sizeof(long);
+    std::vector<long> v(n);
+    for (std::ptrdiff_t i = 0; i < n; ++i)
+      v[i] = i;
+    auto name = [&](char const* op) {
+      return std::string(op) + "/" + std::to_string(n);
+    };
+
+    long k = 0x5a;
+    auto g = [&k](long x) { return x ^ k; };
+
+    r.run(name("function pointer"), n, bytes, [&]() {
+      bench::keep(sum_calls(f_xor, v));
+    });
+    r.run(name("function_ref"), n, bytes, [&]() {
+      bench::keep(sum_calls(stl::function_ref<long(long)>(g), v));
+    });
+    r.run(name("std::function"), n, bytes, [&]() {
+      bench::keep(sum_calls(std::function<long(long)>(g), v));
+    });
+  }
+
+  // Too large for the small buffer of std::function.
+  long a = 1, b = 2, c = 3, d = 4;
+  auto big = [a, b, c, d](long x) { return x + a + b + c + d; };
+  r.run("wrap/function_ref", 1000, 0, [&]() {
+    long sum = 0;
+    for (int i = 0; i < 1000; ++i)
+      sum += call_ref(big);
+    bench::keep(sum);
+  });
+  r.run("wrap/std::function", 1000, 0, [&]() {
+    long sum = 0;
+    for (int i = 0; i < 1000; ++i)
+      sum += call_function(big);
+    bench::keep(sum);
+  });
+}
@@ -0,0 +1,349 @@
+
+#ifndef STL_BENCH_HARNESS_HPP
+#define STL_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__)
+#  include <unistd.h>
+#endif
+
+
+// Benchmark harness
+//
+// A benchmark program creates a runner from its command line, and calls
+// run() for every case. A case is timed after warming up, repeatedly,
+// and the runner reports the median time, percentiles, and throughput
+// in elements and bytes per second. Cases that take less than
+// min_sample are run in a loop, and each sample is the average over
+// that loop. Results are printed as a table and, optionally, written as
+// JSON, one case per line, so that runs of different commits can be
+// compared with diff or with the --baseline option.
+//
+// Options:
+//
+//   --json=FILE       write results to FILE
+//   --baseline=FILE   compare the medians with those in FILE
+//   --filter=TEXT     only run cases whose name contains TEXT
+//   --reps=N          samples per case (default 11)
+//   --warmup=N        untimed runs before sampling (default 1)
+//   --max-time=S      stop sampling a case after S seconds (default 2)
+//   --min-bytes=N     smallest working set (default half the L1 cache)
+//   --max-bytes=N     largest working set (default 4 times the LLC)
+//
+// Programs may also take lists of sizes, as --key=N,N,..., via list().
+//
+// Any other --key=value option is available to the program via get().
+
+namespace bench
+{
+
+using clock_type = std::chrono::steady_clock;
+
+// Prevents the compiler from discarding the computation of x.
+template<typename T>
+inline void
+keep(T const& x)
+{
+  asm volatile("" : : "r,m"(x) : "memory");
+}
+
+
+// The timing of one case. Times are in seconds per iteration.
+struct result
+{
+  std::string name;
+  std::size_t elements;
+  std::size_t bytes;
+  std::vector<double> samples;
+
+  double percentile(double p) const;
+  double median() const { return percentile(50); }
+};
+
+// Interpolates between the samples closest to the percentile.
+inline double
+result::percentile(double p) const
+{
+  std::vector<double> s = samples;
+  std::sort(s.begin(), s.end());
+  double x = p / 100 * (s.size() - 1);
+  std::size_t i = static_cast<std::size_t>(x);
+  if (i + 1 >= s.size())
+    return s.back();
+  return s[i] + (x - i) * (s[i + 1] - s[i]);
+}
+
+
+class runner
+{
+public:
+  runner(int argc, char* argv[], char const* suite);
+  ~runner();
+
+  runner(runner const&) = delete;
+  runner& operator=(runner const&) = delete;
+
+  long get(char const* key, long value) const;
+  std::vector<std::size_t> list(char const* key,
+                                std::vector<std::size_t> value) const;
+
+  std::vector<std::size_t> sizes() const;
+
+  bool selected(std::string const& name) const;
+
+  template<typename F>
+  void run(std::string const& name, std::size_t elements, std::size_t bytes,
+           F f);
+
+  template<typename S, typename F>
+  void run(std::string const& name, std::size_t elements, std::size_t bytes,
+           S setup, F f);
+
+private:
+  void report(result r);
+
+  std::string suite;
+  std::map<std::string, std::string> options;
+  std::map<std::string, double> baseline;
+  std::vector<result> results;
+  int reps;
+  int warmup;
+  double max_time;
+};
+
+constexpr double min_sample = 1e-3;
+
+inline
+runner::runner(int argc, char* argv[], char const* s)
+  : suite(s)
+{
+  for (int i = 1; i < argc; ++i) {
+    char const* arg = argv[i];
+    char const* eq = std::strchr(arg, '=');
+    if (std::strncmp(arg, "--", 2) != 0 || !eq) {
+      std::fprintf(stderr, "error: expected --key=value, got '%s'\n", arg);
+      std::exit(2);
+    }
+    options[std::string(arg + 2, eq)] = eq + 1;
+  }
+  reps = get("reps", 11);
+  warmup = get("warmup", 1);
+  max_time = get("max-time", 2);
+
+  if (options.count("baseline")) {
+    std::ifstream in(options["baseline"]);
+    std::string line;
+    while (std::getline(in, line)) {
+      std::size_t a = line.find("\"name\": \"");
+      std::size_t b = line.find("\"median_ns\": ");
+      if (a == std::string::npos || b == std::string::npos)
+        continue;
+      a += 9;
+      std::string name = line.substr(a, line.find('"', a) - a);
+      baseline[name] = std::atof(line.c_str() + b + 13);
+    }
+  }
+
+  std::printf("%-48s %12s %10s %10s %10s %10s %9s%s\n", suite.c_str(),
+              "elements", "median", "p10", "p90", "Melem/s", "GB/s",
+              baseline.empty() ? "" : "  baseline");
+}
+
+inline
+runner::~runner()
+{
+  if (!options.count("json"))
+    return;
+  std::FILE* f = std::fopen(options["json"].c_str(), "w");
+  if (!f) {
+    std::fprintf(stderr, "error: cannot write '%s'\n", options["json"].c_str());
+    return;
+  }
+  std::fprintf(f, "{\n  \"suite\": \"%s\",\n  \"threads\": %u,\n"
+               "  \"compiler\": \"%s\",\n  \"results\": [\n",
+               suite.c_str(), std::thread::hardware_concurrency(), __VERSION__);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    result const& r = results[i];
+    double m = r.median();
+    std::fprintf(f, "    {\"name\": \"%s\", \"elements\": %zu, \"bytes\": %zu, "
+                 "\"reps\": %zu, \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                 "\"p10_ns\": %.3f, \"p90_ns\": %.3f, \"p99_ns\": %.3f, "
+                 "\"max_ns\": %.3f, \"elements_per_second\": %.6g, "
+                 "\"bytes_per_second\": %.6g}%s\n",
+                 r.name.c_str(), r.elements, r.bytes, r.samples.size(),
+                 m * 1e9, r.percentile(0) * 1e9, r.percentile(10) * 1e9,
+                 r.percentile(90) * 1e9, r.percentile(99) * 1e9,
+                 r.percentile(100) * 1e9, r.elements / m, r.bytes / m,
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+  std::fclose(f);
+}
+
+inline long
+runner::get(char const* key, long value) const
+{
+  auto i = options.find(key);
+  return i == options.end() ? value : std::atol(i->second.c_str());
+}
+
+// Returns the comma separated list of numbers for key, or value if
+// the option is not given.
+inline std::vector<std::size_t>
+runner::list(char const* key, std::vector<std::size_t> value) const
+{
+  auto i = options.find(key);
+  if (i == options.end())
+    return value;
+  std::vector<std::size_t> v;
+  char const* p = i->second.c_str();
+  while (*p) {
+    char* end;
+    v.push_back(std::strtoull(p, &end, 10));
+    p = *end == ',' ? end + 1 : end;
+    if (*end && *end != ',')
+      break;
+  }
+  return v;
+}
+
+// Returns working set sizes in bytes, from a size that fits in the L1
+// cache to one that exceeds the last level cache, growing by 4.
+inline std::vector<std::size_t>
+runner::sizes() const
+{
+  long l1 = 32 << 10;
+  long llc = 32 << 20;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+  if (long n = sysconf(_SC_LEVEL1_DCACHE_SIZE))
+    if (n > 0)
+      l1 = n;
+  if (long n = sysconf(_SC_LEVEL3_CACHE_SIZE))
+    if (n > 0)
+      llc = n;
+#endif
+  std::size_t lo = get("min-bytes", l1 / 2);
+  std::size_t hi = get("max-bytes", 4 * llc);
+  std::vector<std::size_t> v;
+  for (std::size_t n = lo; n <= hi; n *= 4)
+    v.push_back(n);
+  return v;
+}
+
+inline bool
+runner::selected(std::string const& name) const
+{
+  auto i = options.find("filter");
+  return i == options.end() || name.find(i->second) != std::string::npos;
+}
+
+template<typename F>
+void
+runner::run(std::string const& name, std::size_t elements, std::size_t bytes,
+            F f)
+{
+  if (!selected(name))
+    return;
+  for (int i = 0; i < warmup; ++i)
+    f();
+
+  // Find how many iterations make a sample of at least min_sample.
+  long iters = 1;
+  while (true) {
+    auto start = clock_type::now();
+    for (long i = 0; i < iters; ++i)
+      f();
+    std::chrono::duration<double> d = clock_type::now() - start;
+    if (d.count() >= min_sample || iters >= (1l << 30))
+      break;
+    iters *= d.count() > 0 ? std::max(2l, long(min_sample / d.count())) : 64;
+  }
+
+  result r {name, elements, bytes, {}};
+  auto begin = clock_type::now();
+  for (int k = 0; k < reps; ++k) {
+    auto start = clock_type::now();
+    for (long i = 0; i < iters; ++i)
+      f();
+    std::chrono::duration<double> d = clock_type::now() - start;
+    r.samples.push_back(d.count() / iters);
+    std::chrono::duration<double> total = clock_type::now() - begin;
+    if (k >= 2 && total.count() > max_time)
+      break;
+  }
+  report(r);
+}
+
+// As above, but setup() is called before every iteration, untimed. Use
+// it when an iteration consumes its input, e.g., sorting.
+template<typename S, typename F>
+void
+runner::run(std::string const& name, std::size_t elements, std::size_t bytes,
+            S setup, F f)
+{
+  if (!selected(name))
+    return;
+  for (int i = 0; i < warmup; ++i) {
+    setup();
+    f();
+  }
+  result r {name, elements, bytes, {}};
+  auto begin = clock_type::now();
+  for (int k = 0; k < reps; ++k) {
+    double t = 0;
+    long iters = 0;
+    do {
+      setup();
+      auto start = clock_type::now();
+      f();
+      std::chrono::duration<double> d = clock_type::now() - start;
+      t += d.count();
+      ++iters;
+    } while (t < min_sample);
+    r.samples.push_back(t / iters);
+    std::chrono::duration<double> total = clock_type::now() - begin;
+    if (k >= 2 && total.count() > max_time)
+      break;
+  }
+  report(r);
+}
+
+inline void
+runner::report(result r)
+{
+  double m = r.median();
+  auto time = [](double s) {
+    char buf[32];
+    if (s < 1e-6)
+      std::snprintf(buf, sizeof(buf), "%.1f ns", s * 1e9);
+    else if (s < 1e-3)
+      std::snprintf(buf, sizeof(buf), "%.2f us", s * 1e6);
+    else
+      std::snprintf(buf, sizeof(buf), "%.2f ms", s * 1e3);
+    return std::string(buf);
+  };
+  std::printf("%-48s %12zu %10s %10s %10s %10.1f %9.2f", r.name.c_str(),
+              r.elements, time(m).c_str(), time(r.percentile(10)).c_str(),
+              time(r.percentile(90)).c_str(), r.elements / m / 1e6,
+              r.bytes / m / 1e9);
+  auto i = baseline.find(r.name);
+  if (i != baseline.end())
+    std::printf("  %+8.1f%%", (m * 1e9 / i->second - 1) * 100);
+  std::printf("\n");
+  std::fflush(stdout);
+  results.push_back(std::move(r));
+}
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,133 @@
+
+#include "harness.hpp"
+
+#include <std/hash.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+// Measures hashing composite keys, as in a hash join.
+//
+// Each key is hashed with stl::hash, which appends its fields to one
+// wyhash or FNV-1a state, and with std::hash of each field combined as
+// in boost::hash_combine. A key of four integers with no padding is
+// also hashed as one block of bytes.
+//
+// Strings of varying length are hashed with stl::hash and std::hash.
+//
+// Usage: bench_hash [--key=value...]
+//
+// See harness.hpp for the options.
+
+namespace
+{
+
+struct row
+{
+  std::int64_t id;
+  std::int32_t part;
+  std::string name;
+
+  template<stl::HashAlgorithm H>
+  friend void hash_append(H& h, row const& r)
+  {
+    using stl::hash_append;
+    hash_append(h, r.id, r.part, r.name);
+  }
+};
+
+struct quad
+{
+  std::int32_t a, b, c, d;
+};
+
+inline void
+hash_combine(std::size_t& seed, std::size_t h)
+{
+  seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+std::size_t
+std_hash(row const& r)
+{
+  std::size_t seed = 0;
+  hash_combine(seed, std::hash<std::int64_t>()(r.id));
+  hash_combine(seed, std::hash<std::int32_t>()(r.part));
+  hash_combine(seed, std::hash<std::string>()(r.name));
+  return seed;
+}
+
+std::size_t
+std_hash(quad const& q)
+{
+  std::size_t seed = 0;
+  hash_combine(seed, std::hash<std::int32_t>()(q.a));
+  hash_combine(seed, std::hash<std::int32_t>()(q.b));
+  hash_combine(seed, std::hash<std::int32_t>()(q.c));
+  hash_combine(seed, std::hash<std::int32_t>()(q.d));
+  return seed;
+}
+
+} // namespace
+
+namespace stl
+{
+template<>
+struct is_uniquely_represented<quad> : true_type { };
+} // namespace stl
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "hash");
+  for (std::size_t bytes : r.sizes()) {
+    std::size_t n = bytes / sizeof(row);
+    std::vector<row> rows(n);
+    std::vector<quad> quads(n);
+    std::vector<std::string> strings(n);
+    unsigned x = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+      x = x * 1103515245 + 12345;
+      rows[i] = {x, static_cast<std::int32_t>(i % 64), std::to_string(x)};
+      quads[i] = {static_cast<std::int32_t>(x), 1, 2, static_cast<std::int32_t>(i)};
+      strings[i] = std::string(x % 64, 'a');
+    }
+    auto name = [&](char const* op) {
+      return std::string(op) + "/" + std::to_string(n);
+    };
+    auto sum = [](auto const& v, auto h) {
+      std::size_t s = 0;
+      for (auto const& e : v)
+        s += h(e);
+      bench::keep(s);
+    };
+
+    r.run(name("row/stl::hash<wyhash>"), n, bytes, [&]() {
+      sum(rows, stl::hash<row>());
+    });
+    r.run(name("row/stl::hash<fnv1a>"), n, bytes, [&]() {
+      sum(rows, stl::hash<row, stl::fnv1a>());
+    });
+    r.run(name("row/std::hash combine"), n, bytes, [&]() {
+      sum(rows, [](row const& e) { return std_hash(e); });
+    });
+
+    r.run(name("quad/stl::hash<wyhash>"), n, n * sizeof(quad), [&]() {
+      sum(quads, stl::hash<quad>());
+    });
+    r.run(name("quad/std::hash combine"), n, n * sizeof(quad), [&]() {
+      sum(quads, [](quad const& e) { return std_hash(e); });
+    });
+
+    r.run(name("string/stl::hash<wyhash>"), n, 0, [&]() {
+      sum(strings, stl::hash<std::string>());
+    });
+    r.run(name("string/std::hash"), n, 0, [&]() {
+      sum(strings, std::hash<std::string>());
+    });
+  }
+}
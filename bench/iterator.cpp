@@ -0,0 +1,108 @@
+
+#include "harness.hpp"
+
+#include <std/algorithm.hpp>
+
+#include <string>
+#include <vector>
+
+
+// Measures the iterator operations and adaptors.
+//
+// Bounded next(i, n, bound) is compared with unbounded i += n. With a
+// sized sentinel, the bounded form computes the distance to the bound
+// and jumps, so the two should cost the same.
+//
+// Traversal through counted_iterator and reverse_iterator is compared
+// with traversal through the underlying iterator. The adaptors should
+// add no cost.
+//
+// The bounded and unbounded steps are also measured on a vector of 10M
+// elements, or of --advance-elements=N.
+//
+// Usage: bench_iterator [--key=value...]
+//
+// See harness.hpp for the options.
+
+using iter = std::vector<int>::iterator;
+
+// Takes 1000 steps of varying length, some of which overrun the bound.
+void
+steps(bench::runner& r, std::vector<int>& v, std::string const& size)
+{
+  std::ptrdiff_t n = v.size();
+  auto step = [n](std::ptrdiff_t k) { return (k * 7919) % (n / 4 + 1); };
+  r.run("next(i, n, bound)/" + size, 1000, 0, [&]() {
+    iter i = v.begin();
+    for (std::ptrdiff_t k = 0; k < 1000; ++k) {
+      i = stl::next(i, step(k), v.end());
+      if (i == v.end())
+        i = v.begin();
+    }
+    bench::keep(i);
+  });
+  r.run("i += n/" + size, 1000, 0, [&]() {
+    iter i = v.begin();
+    for (std::ptrdiff_t k = 0; k < 1000; ++k) {
+      std::ptrdiff_t s = step(k);
+      std::ptrdiff_t d = v.end() - i;
+      i += s < d ? s : d;
+      if (i == v.end())
+        i = v.begin();
+    }
+    bench::keep(i);
+  });
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "iterator");
+  for (std::size_t bytes : r.sizes()) {
+    std::ptrdiff_t n = bytes / sizeof(int);
+    std::vector<int> v(n, 1);
+    auto name = [&](char const* op) {
+      return std::string(op) + "/" + std::to_string(n);
+    };
+
+    steps(r, v, std::to_string(n));
+
+    r.run(name("distance"), n, 0, [&]() {
+      bench::keep(stl::distance(v.begin(), v.end()));
+    });
+
+    r.run(name("iterator"), n, bytes, [&]() {
+      int sum = 0;
+      for (iter i = v.begin(); i != v.end(); ++i)
+        sum += *i;
+      bench::keep(sum);
+    });
+    r.run(name("counted_iterator"), n, bytes, [&]() {
+      int sum = 0;
+      stl::counted_iterator<iter> i(v.begin(), n);
+      for (; i != stl::default_sentinel{}; ++i)
+        sum += *i;
+      bench::keep(sum);
+    });
+    r.run(name("reverse_iterator"), n, bytes, [&]() {
+      int sum = 0;
+      auto i = stl::make_reverse_iterator(v.end());
+      auto e = stl::make_reverse_iterator(v.begin());
+      for (; i != e; ++i)
+        sum += *i;
+      bench::keep(sum);
+    });
+
+    r.run(name("find(iterator)"), n, bytes, [&]() {
+      bench::keep(stl::find(v.begin(), v.end(), 0));
+    });
+    r.run(name("find(reverse_iterator)"), n, bytes, [&]() {
+      auto e = stl::make_reverse_iterator(v.begin());
+      bench::keep(stl::find(stl::make_reverse_iterator(v.end()), e, 0) == e);
+    });
+  }
+
+  std::vector<int> v(r.get("advance-elements", 10000000), 1);
+  steps(r, v, std::to_string(v.size()));
+}
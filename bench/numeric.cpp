@@ -0,0 +1,66 @@
+
+#include "harness.hpp"
+
+#include <std/numeric.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Measures reductions and scans, serially and in parallel, against a
+// plain loop.
+//
+// Usage: bench_numeric [--key=value...]
+//
+// See harness.hpp for the options.
+
+template<typename T>
+void
+run(bench::runner& r, char const* type, std::size_t bytes)
+{
+  std::size_t n = bytes / sizeof(T);
+  std::vector<T> a(n, T(1));
+  std::vector<T> b(n, T(2));
+  std::vector<T> out(n);
+  auto name = [&](char const* algo) {
+    return std::string(algo) + "/" + type + "/" + std::to_string(n);
+  };
+
+  auto par = stl::execution::par;
+  auto twice = [](T x) { return x * 2; };
+  r.run(name("loop"), n, bytes, [&]() {
+    T sum = 0;
+    for (T x : a)
+      sum += x;
+    bench::keep(sum);
+  });
+  r.run(name("reduce"), n, bytes, [&]() { bench::keep(stl::reduce(a, T(0))); });
+  r.run(name("transform_reduce"), n, bytes, [&]() {
+    bench::keep(stl::transform_reduce(a, T(0), stl::plus<>{}, twice));
+  });
+  r.run(name("inner_product"), n, 2 * bytes, [&]() {
+    bench::keep(stl::transform_reduce(a, b.begin(), T(0)));
+  });
+  r.run(name("inclusive_scan"), n, bytes, [&]() { stl::inclusive_scan(a, out.begin()); });
+  r.run(name("exclusive_scan"), n, bytes, [&]() { stl::exclusive_scan(a, out.begin(), T(0)); });
+  r.run(name("par_reduce"), n, bytes, [&]() { bench::keep(stl::reduce(par, a, T(0))); });
+  r.run(name("par_inner_product"), n, 2 * bytes, [&]() {
+    bench::keep(stl::transform_reduce(par, a, b.begin(), T(0)));
+  });
+  r.run(name("par_inclusive_scan"), n, bytes, [&]() { stl::inclusive_scan(par, a, out.begin()); });
+  r.run(name("par_exclusive_scan"), n, bytes, [&]() { stl::exclusive_scan(par, a, out.begin(), T(0)); });
+  bench::keep(out.data());
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "numeric");
+  for (std::size_t bytes : r.sizes()) {
+    run<std::int32_t>(r, "int32", bytes);
+    run<float>(r, "float", bytes);
+    run<double>(r, "double", bytes);
+  }
+}
@@ -0,0 +1,66 @@
+
+#include "harness.hpp"
+
+#include <std/algorithm.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Measures the scaling of parallel sort and stable_sort with the number
+// of threads, from 1 to the number of hardware threads, doubling. The
+// input is uniformly random 32-bit integers.
+//
+// Usage: bench_parallel_sort [--n=N] [--threads=T] [--key=value...]
+//
+// The size defaults to 100M elements. See harness.hpp for the other
+// options.
+
+template<typename F>
+void
+run(bench::runner& r, std::string const& name, std::vector<int> const& input,
+    F sort)
+{
+  std::vector<int> v;
+  std::size_t n = input.size();
+  r.run(name, n, n * sizeof(int), [&]() { v = input; }, [&]() { sort(v); });
+  if (r.selected(name) && !std::is_sorted(v.begin(), v.end())) {
+    std::fprintf(stderr, "error: %s: not sorted\n", name.c_str());
+    std::exit(1);
+  }
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "parallel_sort");
+  long n = r.get("n", 100000000);
+  int max = r.get("threads", std::thread::hardware_concurrency());
+  if (max < 1)
+    max = 1;
+
+  std::vector<int> input(n);
+  std::mt19937 gen(n);
+  for (int& x : input)
+    x = gen();
+
+  for (int t = 1; ; t = t * 2 < max ? t * 2 : max) {
+    stl::thread_pool pool(t);
+    auto policy = stl::execution::par.on(pool);
+    std::string suffix = "/" + std::to_string(n) + "/threads:" + std::to_string(t);
+    run(r, "sort" + suffix, input, [&](std::vector<int>& v) {
+      stl::sort(policy, v);
+    });
+    run(r, "stable_sort" + suffix, input, [&](std::vector<int>& v) {
+      stl::stable_sort(policy, v);
+    });
+    if (t == max)
+      break;
+  }
+}
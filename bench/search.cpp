@@ -0,0 +1,80 @@
+#include "harness.hpp"
+
+#include <std/algorithm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <vector>
+
+
+// Compares the search family against the scalar all_of loop, serially
+// and in parallel. Each search scans the whole sequence (there is no
+// match), so all of them do the same amount of work.
+//
+// Sequences span the cache sizes, and then have 1K, 1M and 1G elements
+// of each type, unless other counts are given with --elements=N,N,...
+// Counts that cannot be allocated are skipped.
+//
+// Usage: bench_search [--key=value...]
+//
+// See harness.hpp for the options.
+
+template<typename T>
+void
+run(bench::runner& r, char const* type, std::size_t n)
+{
+  std::vector<T> v;
+  try {
+    v.assign(n, T(1));
+  }
+  catch (std::bad_alloc&) {
+    std::printf("%s/%zu skipped (out of memory)\n", type, n);
+    return;
+  }
+  std::size_t bytes = n * sizeof(T);
+  auto name = [&](char const* algo) {
+    return std::string(algo) + "/" + type + "/" + std::to_string(n);
+  };
+
+  auto pos = [](T x) { return x > 0; };
+  auto neg = [](T x) { return x < 0; };
+  auto par = stl::execution::par;
+  r.run(name("all_of"), n, bytes, [&]() { bench::keep(stl::all_of(v.begin(), v.end(), pos)); });
+  r.run(name("find"), n, bytes, [&]() { bench::keep(stl::find(v, T(0)) == v.end()); });
+  r.run(name("find_if"), n, bytes, [&]() { bench::keep(stl::find_if(v, neg) == v.end()); });
+  r.run(name("find_if_not"), n, bytes, [&]() { bench::keep(stl::find_if_not(v, pos) == v.end()); });
+  r.run(name("any_of"), n, bytes, [&]() { bench::keep(stl::any_of(v, neg)); });
+  r.run(name("none_of"), n, bytes, [&]() { bench::keep(stl::none_of(v, neg)); });
+  r.run(name("par_all_of"), n, bytes, [&]() { bench::keep(stl::all_of(par, v, pos)); });
+  r.run(name("par_find"), n, bytes, [&]() { bench::keep(stl::find(par, v, T(0)) == v.end()); });
+  r.run(name("par_find_if"), n, bytes, [&]() { bench::keep(stl::find_if(par, v, neg) == v.end()); });
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "search");
+  std::vector<std::size_t> sizes = r.sizes();
+  for (std::size_t bytes : sizes) {
+    run<std::int8_t>(r, "int8", bytes / sizeof(std::int8_t));
+    run<std::int32_t>(r, "int32", bytes / sizeof(std::int32_t));
+    run<std::int64_t>(r, "int64", bytes / sizeof(std::int64_t));
+  }
+
+  // Skip the counts that were already run as cache sizes.
+  auto fresh = [&](std::size_t bytes) {
+    return std::find(sizes.begin(), sizes.end(), bytes) == sizes.end();
+  };
+  for (std::size_t n : r.list("elements", {1u << 10, 1u << 20, 1u << 30})) {
+    if (fresh(n * sizeof(std::int8_t)))
+      run<std::int8_t>(r, "int8", n);
+    if (fresh(n * sizeof(std::int32_t)))
+      run<std::int32_t>(r, "int32", n);
+    if (fresh(n * sizeof(std::int64_t)))
+      run<std::int64_t>(r, "int64", n);
+  }
+}
@@ -0,0 +1,85 @@
+
+#include "harness.hpp"
+
+#include <std/algorithm.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Compares stl::sort, stl::stable_sort and stl::radix_sort with
+// std::sort and std::stable_sort on random, sorted, reverse sorted, many
+// duplicates and organ pipe inputs.
+//
+// Usage: bench_sort [--key=value...]
+//
+// See harness.hpp for the options.
+
+std::vector<int>
+make_input(std::string const& kind, int n)
+{
+  std::vector<int> v(n);
+  std::mt19937 gen(n);
+  for (int i = 0; i < n; ++i) {
+    if (kind == "random")
+      v[i] = gen();
+    else if (kind == "sorted")
+      v[i] = i;
+    else if (kind == "reverse")
+      v[i] = n - i;
+    else if (kind == "dups")
+      v[i] = gen() % 16;
+    else if (kind == "organ")
+      v[i] = i < n / 2 ? i : n - i;
+  }
+  return v;
+}
+
+template<typename F>
+void
+run(bench::runner& r, std::string const& name, std::vector<int> const& input,
+    F sort)
+{
+  std::vector<int> v;
+  std::size_t n = input.size();
+  r.run(name, n, n * sizeof(int), [&]() { v = input; }, [&]() { sort(v); });
+  if (r.selected(name) && !std::is_sorted(v.begin(), v.end())) {
+    std::fprintf(stderr, "error: %s: not sorted\n", name.c_str());
+    std::exit(1);
+  }
+}
+
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "sort");
+  for (std::size_t bytes : r.sizes()) {
+    int n = bytes / sizeof(int);
+    for (char const* kind : {"random", "sorted", "reverse", "dups", "organ"}) {
+      std::vector<int> input = make_input(kind, n);
+      auto name = [&](char const* algo) {
+        return std::string(algo) + "/" + kind + "/" + std::to_string(n);
+      };
+      run(r, name("std::sort"), input, [](std::vector<int>& v) {
+        std::sort(v.begin(), v.end());
+      });
+      run(r, name("sort"), input, [](std::vector<int>& v) {
+        stl::sort(v);
+      });
+      run(r, name("radix_sort"), input, [](std::vector<int>& v) {
+        stl::radix_sort(v);
+      });
+      run(r, name("std::stable_sort"), input, [](std::vector<int>& v) {
+        std::stable_sort(v.begin(), v.end());
+      });
+      run(r, name("stable_sort"), input, [](std::vector<int>& v) {
+        stl::stable_sort(v);
+      });
+    }
+  }
+}
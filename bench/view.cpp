@@ -0,0 +1,103 @@
+
+#include "harness.hpp"
+
+#include <std/view.hpp>
+
+#include <string>
+#include <vector>
+
+
+// Compares a pipeline of views with a hand-written loop, and with the
+// same pipeline materialized into a temporary vector at every step.
+//
+// Usage: bench_view [--key=value...]
+//
+// See harness.hpp for the options.
+
+int
+main(int argc, char* argv[])
+{
+  bench::runner r(argc, argv, "view");
+  auto odd = [](int x) { return x % 2 != 0; };
+  auto square = [](int x) { return x * x; };
+  for (std::size_t bytes : r.sizes()) {
+    std::size_t n = bytes / sizeof(int);
+    std::vector<int> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+      v[i] = i % 1000;
+    auto name = [&](char const* kind) {
+      return std::string(kind) + "/" + std::to_string(n);
+    };
+
+    r.run(name("loop"), n, bytes, [&]() {
+      int sum = 0;
+      for (int x : v)
+        if (odd(x))
+          sum += square(x);
+      bench::keep(sum);
+    });
+    r.run(name("view"), n, bytes, [&]() {
+      int sum = 0;
+      for (int x : v | stl::view::filter(odd) | stl::view::transform(square))
+        sum += x;
+      bench::keep(sum);
+    });
+    r.run(name("materialized"), n, bytes, [&]() {
+      std::vector<int> a;
+      for (int x : v)
+        if (odd(x))
+          a.push_back(x);
+      std::vector<int> b;
+      for (int x : a)
+        b.push_back(square(x));
+      int sum = 0;
+      for (int x : b)
+        sum += x;
+      bench::keep(sum);
+    });
+    r.run(name("view+take"), n / 2, bytes / 2, [&]() {
+      int sum = 0;
+      for (int x : v | stl::view::transform(square) | stl::view::take(n / 2))
+        sum += x;
+      bench::keep(sum);
+    });
+    std::vector<int> w(v.rbegin(), v.rend());
+    r.run(name("zip"), n, 2 * bytes, [&]() {
+      int sum = 0;
+      for (auto [a, b] : stl::view::zip(v, w))
+        sum += a * b;
+      bench::keep(sum);
+    });
+    r.run(name("zip/loop"), n, 2 * bytes, [&]() {
+      int sum = 0;
+      for (std::size_t i = 0; i < n; ++i)
+        sum += v[i] * w[i];
+      bench::keep(sum);
+    });
+    std::string text(bytes, 'x');
+    for (std::size_t i = 79; i < bytes; i += 80)
+      text[i] = '\n';
+    r.run(name("lines"), bytes / 80, bytes, [&]() {
+      std::size_t len = 0;
+      for (auto line : text | stl::view::lines)
+        len += line.size();
+      bench::keep(len);
+    });
+    r.run(name("lines/loop"), bytes / 80, bytes, [&]() {
+      std::size_t len = 0;
+      std::size_t start = 0;
+      for (std::size_t i = 0; i < text.size(); ++i)
+        if (text[i] == '\n') {
+          len += i - start;
+          start = i + 1;
+        }
+      bench::keep(len + text.size() - start);
+    });
+    r.run(name("counted"), n, bytes, [&]() {
+      int sum = 0;
+      for (int x : stl::view::counted(v.begin(), n))
+        sum += x;
+      bench::keep(sum);
+    });
+  }
+}
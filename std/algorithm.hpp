@@ -4,30 +4,702 @@
 
 #include "iterator.hpp"
 #include "range.hpp"
+#include "execution.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#endif
 
 
 namespace stl
 {
 
+// Deque segments
+//
+// The blocks of a deque are its segments. The end of a deque refers to
+// an allocated block, so every iterator has a segment. The traits are
+// here, with the segmented kernels, so that iterator.hpp does not need
+// <deque>.
+#if defined(__GLIBCXX__)
+template<typename T, typename R, typename P>
+struct segmented_iterator_traits<std::_Deque_iterator<T, R, P>>
+{
+  using I = std::_Deque_iterator<T, R, P>;
+
+  static constexpr bool is_segmented = true;
+
+  using segment_iterator = typename I::_Map_pointer;
+  using local_iterator = P;
+
+  static segment_iterator segment(I i) { return i._M_node; }
+  static P local(I i) { return i._M_cur; }
+
+  static P begin(segment_iterator s) { return *s; }
+  static P end(segment_iterator s) { return *s + I::_S_buffer_size(); }
+
+  static I compose(I i, segment_iterator s, P l)
+  {
+    i._M_set_node(s);
+    i._M_cur = i._M_first + (l - *s);
+    return i;
+  }
+
+  static bool has_segment(I) { return true; }
+};
+#endif
+
+
+// Search kernels
+//
+// Searches over contiguous sequences of arithmetic values are lowered
+// onto pointers and run a block at a time. Equality searches for
+// integral values compare 16 (SSE2) or 32 (AVX2) bytes per vector,
+// four vectors per iteration. Predicate searches evaluate the predicate
+// over a 64 byte block without branching, which the compiler is free to
+// vectorize, and only go element-wise in the block with the match.
+//
+// NOTE: Block evaluation may apply the predicate to elements past the
+// first match. That is allowed because predicates are required to be
+// regular functions.
+//
+// A search whose sentinel is unreachable_sentinel is unguarded: the
+// caller guarantees that there is a match, so the loop has no end test.
+// Random access searches are unrolled four elements per iteration.
+// Equality searches over contiguous integral values first step to a
+// vector-aligned address and then load whole aligned vectors. An aligned
+// load never crosses a page boundary, so the vector holding the match
+// can be read even if the elements after the match are past the end of
+// the buffer (as strlen does).
+
+namespace impl
+{
+
+template<typename T>
+concept bool VectorComparable()
+{
+  return Integral<T>() &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+}
+
+
+// Returns a pointer to the element referred to by a contiguous iterator.
+// The iterator must be dereferenceable.
+template<ContiguousIterator I>
+inline remove_reference_t<reference_t<I>>*
+address(I i)
+{
+  return std::addressof(*i);
+}
+
+
+#if defined(__SSE2__)
+template<std::size_t N>
+struct sse2_ops
+{
+  using vec = __m128i;
+
+  static vec load(void const* p)
+  {
+    return _mm_loadu_si128(static_cast<__m128i const*>(p));
+  }
+
+  static vec bit_or(vec a, vec b) { return _mm_or_si128(a, b); }
+
+  static unsigned mask(vec a) { return _mm_movemask_epi8(a); }
+
+  template<typename T>
+  static vec splat(T x)
+  {
+    if (N == 1) return _mm_set1_epi8(static_cast<char>(x));
+    if (N == 2) return _mm_set1_epi16(static_cast<short>(x));
+    if (N == 4) return _mm_set1_epi32(static_cast<int>(x));
+    return _mm_set1_epi64x(static_cast<long long>(x));
+  }
+
+  // SSE2 has no 64-bit compare; both 32-bit halves must match.
+  static vec eq(vec a, vec b)
+  {
+    if (N == 1) return _mm_cmpeq_epi8(a, b);
+    if (N == 2) return _mm_cmpeq_epi16(a, b);
+    vec c = _mm_cmpeq_epi32(a, b);
+    if (N == 4) return c;
+    return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+};
+#endif
+
+#if defined(__AVX2__)
+template<std::size_t N>
+struct avx2_ops
+{
+  using vec = __m256i;
+
+  static vec load(void const* p)
+  {
+    return _mm256_loadu_si256(static_cast<__m256i const*>(p));
+  }
+
+  static vec bit_or(vec a, vec b) { return _mm256_or_si256(a, b); }
+
+  static unsigned mask(vec a) { return _mm256_movemask_epi8(a); }
+
+  template<typename T>
+  static vec splat(T x)
+  {
+    if (N == 1) return _mm256_set1_epi8(static_cast<char>(x));
+    if (N == 2) return _mm256_set1_epi16(static_cast<short>(x));
+    if (N == 4) return _mm256_set1_epi32(static_cast<int>(x));
+    return _mm256_set1_epi64x(static_cast<long long>(x));
+  }
+
+  static vec eq(vec a, vec b)
+  {
+    if (N == 1) return _mm256_cmpeq_epi8(a, b);
+    if (N == 2) return _mm256_cmpeq_epi16(a, b);
+    if (N == 4) return _mm256_cmpeq_epi32(a, b);
+    return _mm256_cmpeq_epi64(a, b);
+  }
+};
+#endif
+
+
+template<typename Ops, typename T>
+T const*
+find_vector_with(T const* first, T const* last, T value)
+{
+  using vec = typename Ops::vec;
+  constexpr std::ptrdiff_t lanes = sizeof(vec) / sizeof(T);
+  vec const v = Ops::splat(value);
+
+  // Skip four vectors at a time. When one of them matches, fall
+  // through to locate the exact position.
+  while (last - first >= 4 * lanes) {
+    vec a = Ops::eq(Ops::load(first), v);
+    vec b = Ops::eq(Ops::load(first + lanes), v);
+    vec c = Ops::eq(Ops::load(first + 2 * lanes), v);
+    vec d = Ops::eq(Ops::load(first + 3 * lanes), v);
+    if (Ops::mask(Ops::bit_or(Ops::bit_or(a, b), Ops::bit_or(c, d))))
+      break;
+    first += 4 * lanes;
+  }
+  while (last - first >= lanes) {
+    if (unsigned m = Ops::mask(Ops::eq(Ops::load(first), v)))
+      return first + __builtin_ctz(m) / sizeof(T);
+    first += lanes;
+  }
+  while (first != last && *first != value)
+    ++first;
+  return first;
+}
+
+
+template<VectorComparable T>
+inline T const*
+find_vector(T const* first, T const* last, T value)
+{
+#if defined(__AVX2__)
+  return find_vector_with<avx2_ops<sizeof(T)>>(first, last, value);
+#elif defined(__SSE2__)
+  return find_vector_with<sse2_ops<sizeof(T)>>(first, last, value);
+#else
+  while (first != last && *first != value)
+    ++first;
+  return first;
+#endif
+}
+
+
+// The block accumulator has the width of the element type so that the
+// accumulation packs into the same vector lanes as the elements.
+template<std::size_t N>
+struct block_mask
+{
+  using type = unsigned char;
+};
+
+template<>
+struct block_mask<2>
+{
+  using type = unsigned short;
+};
+
+template<>
+struct block_mask<4>
+{
+  using type = unsigned int;
+};
+
+template<>
+struct block_mask<8>
+{
+  using type = unsigned long long;
+};
+
+// The predicate is applied once to each element of a block, and the
+// results are kept so that a block with a hit is not evaluated again.
+// It may be applied to elements past the result within its block, but
+// never more than last - first times in all.
+template<typename T, typename P>
+T*
+find_if_blocked(T* first, T* last, P& pred)
+{
+  using M = typename block_mask<sizeof(T)>::type;
+  constexpr std::ptrdiff_t block = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+  while (last - first >= block) {
+    M hits[block];
+    M any = 0;
+    for (std::ptrdiff_t i = 0; i < block; ++i) {
+      hits[i] = static_cast<M>(static_cast<bool>(stl::invoke(pred, first[i])));
+      any |= hits[i];
+    }
+    if (any) {
+      std::ptrdiff_t i = 0;
+      while (!hits[i])
+        ++i;
+      return first + i;
+    }
+    first += block;
+  }
+  while (first != last && !stl::invoke(pred, *first))
+    ++first;
+  return first;
+}
+
+
+template<typename I, typename S, typename T>
+I
+find(I first, S last, T const& value)
+{
+  while (first != last && !(*first == value))
+    ++first;
+  return first;
+}
+
+// Values that are not representable in the element type cannot compare
+// equal to any element.
+template<ContiguousIterator I, SizedSentinel<I> S, typename U>
+  requires VectorComparable<value_type_t<I>>() && is_arithmetic_v<U>
+I
+find(I first, S last, U const& value)
+{
+  using V = value_type_t<I>;
+  difference_type_t<I> n = last - first;
+  V v = static_cast<V>(value);
+  if (n == 0 || !(v == value))
+    return first + n;
+  V const* p = address(first);
+  return first + (find_vector(p, p + n, v) - p);
+}
+
+
+template<typename I, typename S, typename P>
+I
+find_if(I first, S last, P pred)
+{
+  while (first != last && !stl::invoke(pred, *first))
+    ++first;
+  return first;
+}
+
+template<ContiguousIterator I, SizedSentinel<I> S, typename P>
+  requires is_arithmetic_v<value_type_t<I>>
+I
+find_if(I first, S last, P pred)
+{
+  difference_type_t<I> n = last - first;
+  if (n == 0)
+    return first;
+  auto p = address(first);
+  return first + (find_if_blocked(p, p + n, pred) - p);
+}
+
+
+// Segmented kernels
+//
+// An algorithm over a segmented sequence runs over the local range of
+// each segment in turn, so the inner loop is that of the local
+// iterators (a pointer loop, or a vector search, for a deque).
+
+// Applies f(lfirst, llast) to the local ranges of [first, last).
+template<SegmentedIterator I, typename F>
+void
+for_each_segment(I first, I last, F f)
+{
+  using X = segmented_iterator_traits<I>;
+  if (first == last)
+    return;
+  auto s = X::segment(first);
+  auto sl = X::segment(last);
+  if (s == sl) {
+    f(X::local(first), X::local(last));
+    return;
+  }
+  f(X::local(first), X::end(s));
+  for (++s; s != sl; ++s)
+    f(X::begin(s), X::end(s));
+  if (X::has_segment(last))
+    f(X::begin(sl), X::local(last));
+}
+
+// Returns the first position in [first, last) found by search(lfirst,
+// llast), which returns llast when there is none in a local range.
+template<SegmentedIterator I, typename F>
+I
+search_segments(I first, I last, F search)
+{
+  using X = segmented_iterator_traits<I>;
+  if (first == last)
+    return last;
+  auto s = X::segment(first);
+  auto sl = X::segment(last);
+  if (s == sl) {
+    auto i = search(X::local(first), X::local(last));
+    return i == X::local(last) ? last : X::compose(first, s, i);
+  }
+  auto i = search(X::local(first), X::end(s));
+  if (i != X::end(s))
+    return X::compose(first, s, i);
+  for (++s; s != sl; ++s) {
+    i = search(X::begin(s), X::end(s));
+    if (i != X::end(s))
+      return X::compose(first, s, i);
+  }
+  if (X::has_segment(last)) {
+    i = search(X::begin(sl), X::local(last));
+    if (i != X::local(last))
+      return X::compose(first, sl, i);
+  }
+  return last;
+}
+
+
+template<SegmentedIterator I, typename T>
+I
+find(I first, I last, T const& value)
+{
+  return impl::search_segments(first, last, [&value](auto f, auto l) {
+    return impl::find(f, l, value);
+  });
+}
+
+template<SegmentedIterator I, typename P>
+I
+find_if(I first, I last, P pred)
+{
+  return impl::search_segments(first, last, [&pred](auto f, auto l) {
+    return impl::find_if(f, l, pred);
+  });
+}
+
+
+// Unguarded kernels
+
+template<typename I, typename T>
+I
+find(I first, unreachable_sentinel, T const& value)
+{
+  while (!(*first == value))
+    ++first;
+  return first;
+}
+
+template<RandomAccessIterator I, typename T>
+I
+find(I first, unreachable_sentinel, T const& value)
+{
+  for (;; first += 4) {
+    if (first[0] == value) return first;
+    if (first[1] == value) return first + 1;
+    if (first[2] == value) return first + 2;
+    if (first[3] == value) return first + 3;
+  }
+}
+
+#if defined(__SSE2__)
+// Reads up to the end of the aligned vector holding the match, which
+// may be past the end of the object, so this is not instrumented.
+template<typename Ops, typename T>
+__attribute__((no_sanitize_address))
+T const*
+find_vector_unguarded_with(T const* first, T value)
+{
+  using vec = typename Ops::vec;
+  constexpr std::ptrdiff_t lanes = sizeof(vec) / sizeof(T);
+  while (reinterpret_cast<std::uintptr_t>(first) % sizeof(vec) != 0) {
+    if (*first == value)
+      return first;
+    ++first;
+  }
+  vec const v = Ops::splat(value);
+  while (true) {
+    if (unsigned m = Ops::mask(Ops::eq(Ops::load(first), v)))
+      return first + __builtin_ctz(m) / sizeof(T);
+    first += lanes;
+  }
+}
+#endif
+
+template<ContiguousIterator I, typename U>
+  requires VectorComparable<value_type_t<I>>() && is_arithmetic_v<U>
+I
+find(I first, unreachable_sentinel, U const& value)
+{
+#if defined(__SSE2__)
+  using V = value_type_t<I>;
+  V v = static_cast<V>(value);
+  if (v == value) {
+    V const* p = address(first);
+#  if defined(__AVX2__)
+    return first + (find_vector_unguarded_with<avx2_ops<sizeof(V)>>(p, v) - p);
+#  else
+    return first + (find_vector_unguarded_with<sse2_ops<sizeof(V)>>(p, v) - p);
+#  endif
+  }
+#endif
+  for (;; first += 4) {
+    if (first[0] == value) return first;
+    if (first[1] == value) return first + 1;
+    if (first[2] == value) return first + 2;
+    if (first[3] == value) return first + 3;
+  }
+}
+
+
+template<typename I, typename P>
+I
+find_if(I first, unreachable_sentinel, P pred)
+{
+  while (!stl::invoke(pred, *first))
+    ++first;
+  return first;
+}
+
+template<RandomAccessIterator I, typename P>
+I
+find_if(I first, unreachable_sentinel, P pred)
+{
+  for (;; first += 4) {
+    if (stl::invoke(pred, first[0])) return first;
+    if (stl::invoke(pred, first[1])) return first + 1;
+    if (stl::invoke(pred, first[2])) return first + 2;
+    if (stl::invoke(pred, first[3])) return first + 3;
+  }
+}
+
+
+// Searches for the first occurrence of [first2, last2) in [first1,
+// last1). The first element of the pattern is found with find, which
+// runs the vector and unguarded kernels; the rest is compared element
+// by element.
+template<typename I1, typename S1, typename I2, typename S2>
+I1
+search(I1 first1, S1 last1, I2 first2, S2 last2)
+{
+  if (first2 == last2)
+    return first1;
+  I2 second = first2;
+  ++second;
+  while (true) {
+    first1 = impl::find(first1, last1, *first2);
+    if (first1 == last1)
+      return first1;
+    I1 i = first1;
+    I2 j = second;
+    while (true) {
+      if (j == last2)
+        return first1;
+      if (++i == last1)
+        return i;
+      if (!(*i == *j))
+        break;
+      ++j;
+    }
+    ++first1;
+  }
+}
+
+
+// Apply a search to the range, or, if the range is contiguous, to the
+// pointers underlying it, which data() exposes.
+template<typename R, typename F>
+iterator_t<R>
+search_range(R& range, F search)
+{
+  return search(begin(range), end(range));
+}
+
+template<ContiguousRange R, typename F>
+iterator_t<R>
+search_range(R& range, F search)
+{
+  auto p = data(range);
+  return begin(range) + (search(p, p + size(range)) - p);
+}
+
+} // namespace impl
+
+
+// Find
+
+template<InputIterator I, Sentinel<I> S, typename T>
+  requires IndirectRelation<equal_to<>, I, T const*>()
+inline I
+find(I first, S last, T const& value)
+{
+  return impl::find(first, last, value);
+}
+
+template<InputRange R, typename T>
+  requires IndirectRelation<equal_to<>, iterator_t<R>, T const*>()
+inline iterator_t<R>
+find(R&& range, T const& value)
+{
+  return impl::search_range(range, [&value](auto first, auto last) {
+    return impl::find(first, last, value);
+  });
+}
+
+// Find (projected)
+
+template<InputIterator I, Sentinel<I> S, typename T, typename X>
+  requires IndirectRelation<equal_to<>, projected<I, X>, T const*>()
+inline I
+find(I first, S last, T const& value, X proj)
+{
+  return impl::find_if(first, last, [&](auto&& x) -> bool {
+    return stl::invoke(proj, x) == value;
+  });
+}
+
+template<InputRange R, typename T, typename X>
+  requires IndirectRelation<equal_to<>, projected<iterator_t<R>, X>, T const*>()
+inline iterator_t<R>
+find(R&& range, T const& value, X proj)
+{
+  return impl::search_range(range, [&](auto first, auto last) {
+    return impl::find_if(first, last, [&](auto&& x) -> bool {
+      return stl::invoke(proj, x) == value;
+    });
+  });
+}
+
+
+// Find if
+
+template<InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline I
+find_if(I first, S last, P pred)
+{
+  return impl::find_if(first, last, pred);
+}
+
+template<InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline iterator_t<R>
+find_if(R&& range, P pred)
+{
+  return impl::search_range(range, [&pred](auto first, auto last) {
+    return impl::find_if(first, last, pred);
+  });
+}
+
+// Find if (projected)
+
+template<InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline I
+find_if(I first, S last, P pred, X proj)
+{
+  return impl::find_if(first, last, [&](auto&& x) -> bool {
+    return stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+template<InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline iterator_t<R>
+find_if(R&& range, P pred, X proj)
+{
+  return impl::search_range(range, [&](auto first, auto last) {
+    return impl::find_if(first, last, [&](auto&& x) -> bool {
+      return stl::invoke(pred, stl::invoke(proj, x));
+    });
+  });
+}
+
+
+// Find if not
+
+template<InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline I
+find_if_not(I first, S last, P pred)
+{
+  return impl::find_if(first, last, [&pred](auto&& x) -> bool {
+    return !stl::invoke(pred, x);
+  });
+}
+
+template<InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline iterator_t<R>
+find_if_not(R&& range, P pred)
+{
+  return impl::search_range(range, [&pred](auto first, auto last) {
+    return impl::find_if(first, last, [&pred](auto&& x) -> bool {
+      return !stl::invoke(pred, x);
+    });
+  });
+}
+
+// Find if not (projected)
+
+template<InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline I
+find_if_not(I first, S last, P pred, X proj)
+{
+  return impl::find_if(first, last, [&](auto&& x) -> bool {
+    return !stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+template<InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline iterator_t<R>
+find_if_not(R&& range, P pred, X proj)
+{
+  return impl::search_range(range, [&](auto first, auto last) {
+    return impl::find_if(first, last, [&](auto&& x) -> bool {
+      return !stl::invoke(pred, stl::invoke(proj, x));
+    });
+  });
+}
+
+
 // All of
 
 template<InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
-bool
+inline bool
 all_of(I first, S last, P pred)
 {
-  while (first != last) {
-    if (!pred(*first))
-      return false;
-    ++first;
-  }
-  return true;
+  return stl::find_if_not(first, last, pred) == last;
 }
 
 template<InputRange R, IndirectPredicate<iterator_t<R>> P>
-bool
+inline bool
 all_of(R&& range, P pred)
 {
-  return all_of(begin(range), end(range), pred);
+  return stl::find_if_not(range, pred) == end(range);
 }
 
 template<typename T, Predicate<T> P>
@@ -41,33 +713,2153 @@ all_of(std::initializer_list<T> list, P pred)
 
 template<InputIterator I, Sentinel<I> S, typename P, typename X>
   requires IndirectPredicate<P, projected<I, X>>()
-bool
+inline bool
 all_of(I first, S last, P pred, X proj)
 {
-  while (first != last) {
-    if (!pred(proj(*first)))
-      return false;
-    ++first;
-  }
-  return true;
+  return stl::find_if_not(first, last, pred, proj) == last;
 }
 
 template<InputRange R, typename P, typename X>
   requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
-bool
+inline bool
 all_of(R&& range, P pred, X proj)
 {
-  return all_of(begin(range), end(range), pred, proj);
+  return stl::find_if_not(range, pred, proj) == end(range);
 }
 
 template<typename T, typename P, typename X>
-  requires Predicate<P, result_of_t<X(T)>>()
+  requires Predicate<P, invoke_result_t<X&, T const&>>()
 inline bool
 all_of(std::initializer_list<T> list, P pred, X proj)
 {
   return all_of(list.begin(), list.end(), pred, proj);
 }
 
+
+// Any of
+
+template<InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline bool
+any_of(I first, S last, P pred)
+{
+  return stl::find_if(first, last, pred) != last;
+}
+
+template<InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline bool
+any_of(R&& range, P pred)
+{
+  return stl::find_if(range, pred) != end(range);
+}
+
+template<typename T, Predicate<T> P>
+inline bool
+any_of(std::initializer_list<T> list, P pred)
+{
+  return any_of(list.begin(), list.end(), pred);
+}
+
+// Any of (projected)
+
+template<InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline bool
+any_of(I first, S last, P pred, X proj)
+{
+  return stl::find_if(first, last, pred, proj) != last;
+}
+
+template<InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline bool
+any_of(R&& range, P pred, X proj)
+{
+  return stl::find_if(range, pred, proj) != end(range);
+}
+
+template<typename T, typename P, typename X>
+  requires Predicate<P, invoke_result_t<X&, T const&>>()
+inline bool
+any_of(std::initializer_list<T> list, P pred, X proj)
+{
+  return any_of(list.begin(), list.end(), pred, proj);
+}
+
+
+// None of
+
+template<InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline bool
+none_of(I first, S last, P pred)
+{
+  return stl::find_if(first, last, pred) == last;
+}
+
+template<InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline bool
+none_of(R&& range, P pred)
+{
+  return stl::find_if(range, pred) == end(range);
+}
+
+template<typename T, Predicate<T> P>
+inline bool
+none_of(std::initializer_list<T> list, P pred)
+{
+  return none_of(list.begin(), list.end(), pred);
+}
+
+// None of (projected)
+
+template<InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline bool
+none_of(I first, S last, P pred, X proj)
+{
+  return stl::find_if(first, last, pred, proj) == last;
+}
+
+template<InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline bool
+none_of(R&& range, P pred, X proj)
+{
+  return stl::find_if(range, pred, proj) == end(range);
+}
+
+template<typename T, typename P, typename X>
+  requires Predicate<P, invoke_result_t<X&, T const&>>()
+inline bool
+none_of(std::initializer_list<T> list, P pred, X proj)
+{
+  return none_of(list.begin(), list.end(), pred, proj);
+}
+
+
+// Search
+//
+// Returns the first position in [first1, last1) where the elements of
+// [first2, last2) occur, or last1 if they do not.
+
+template<ForwardIterator I1, Sentinel<I1> S1, ForwardIterator I2, Sentinel<I2> S2>
+  requires IndirectlyComparable<I1, I2, equal_to<>>()
+inline I1
+search(I1 first1, S1 last1, I2 first2, S2 last2)
+{
+  return impl::search(first1, last1, first2, last2);
+}
+
+template<ForwardRange R1, ForwardRange R2>
+  requires IndirectlyComparable<iterator_t<R1>, iterator_t<R2>, equal_to<>>()
+inline iterator_t<R1>
+search(R1&& range1, R2&& range2)
+{
+  return impl::search_range(range1, [&range2](auto first, auto last) {
+    return impl::search(first, last, begin(range2), end(range2));
+  });
+}
+
+
+// Guarded find
+//
+// Finds value in [first, last) by writing value to the last element,
+// so that the search is unguarded, and restoring it afterwards. The
+// sequence must not be accessed by other threads during the search.
+// When the stored value does not compare equal to value (it is not
+// representable in the element type, or is a NaN), it cannot stop the
+// search, so the search is bounded instead.
+
+template<BidirectionalIterator I, typename T>
+  requires IndirectRelation<equal_to<>, I, T const*>() &&
+           Writable<I, T const&>() && Writable<I, value_type_t<I>>()
+I
+guarded_find(I first, I last, T const& value)
+{
+  if (first == last)
+    return last;
+  I back = stl::prev(last);
+  value_type_t<I> saved = iter_move(back);
+  *back = value;
+  if (!(*back == value)) {
+    *back = std::move(saved);
+    return impl::find(first, last, value);
+  }
+  I i = impl::find(first, unreachable_sentinel{}, value);
+  *back = std::move(saved);
+  if (i == back && !(*back == value))
+    return last;
+  return i;
+}
+
+template<BidirectionalRange R, typename T>
+  requires BoundedRange<R>() &&
+           IndirectRelation<equal_to<>, iterator_t<R>, T const*>() &&
+           Writable<iterator_t<R>, T const&>() &&
+           Writable<iterator_t<R>, value_type_t<iterator_t<R>>>()
+inline iterator_t<R>
+guarded_find(R&& range, T const& value)
+{
+  return stl::guarded_find(begin(range), end(range), value);
+}
+
+
+// Copy and fill kernels
+//
+// Copies between contiguous sequences of the same trivially copyable
+// type are a single memmove. Fills of contiguous integral sequences are
+// a single memset when every byte of the value is the same (e.g., any
+// byte value, or zero).
+
+namespace impl
+{
+
+template<typename I, typename O>
+concept bool MemoryCopyable()
+{
+  return ContiguousIterator<I>() && ContiguousIterator<O>() &&
+    SameAs<value_type_t<I>, value_type_t<O>>() &&
+    is_trivially_copyable_v<value_type_t<I>>;
+}
+
+
+template<typename I, typename S, typename O>
+std::pair<I, O>
+copy(I first, S last, O result)
+{
+  for (; first != last; ++first, ++result)
+    *result = *first;
+  return {first, result};
+}
+
+template<typename I, typename S, typename O>
+  requires MemoryCopyable<I, O>() && SizedSentinel<S, I>()
+std::pair<I, O>
+copy(I first, S last, O result)
+{
+  difference_type_t<I> n = last - first;
+  if (n > 0)
+    std::memmove(address(result), address(first), n * sizeof(value_type_t<I>));
+  return {first + n, result + n};
+}
+
+
+template<SegmentedIterator I, WeaklyIncrementable O>
+std::pair<I, O>
+copy(I first, I last, O result)
+{
+  impl::for_each_segment(first, last, [&result](auto f, auto l) {
+    result = impl::copy(f, l, result).second;
+  });
+  return {last, result};
+}
+
+
+template<typename I, typename O>
+std::pair<I, O>
+copy_n(I first, difference_type_t<I> n, O result)
+{
+  for (; n > 0; --n, ++first, ++result)
+    *result = *first;
+  return {first, result};
+}
+
+template<typename I, typename O>
+  requires MemoryCopyable<I, O>()
+std::pair<I, O>
+copy_n(I first, difference_type_t<I> n, O result)
+{
+  if (n > 0) {
+    std::memmove(address(result), address(first), n * sizeof(value_type_t<I>));
+    return {first + n, result + n};
+  }
+  return {first, result};
+}
+
+
+template<typename I, typename S, typename O>
+std::pair<I, O>
+move(I first, S last, O result)
+{
+  for (; first != last; ++first, ++result)
+    *result = iter_move(first);
+  return {first, result};
+}
+
+template<typename I, typename S, typename O>
+  requires MemoryCopyable<I, O>() && SizedSentinel<S, I>()
+inline std::pair<I, O>
+move(I first, S last, O result)
+{
+  return impl::copy(first, last, result);
+}
+
+
+template<typename I, typename S, typename O>
+std::pair<I, O>
+move_backward(I first, S last, O result)
+{
+  I i = first;
+  stl::advance(i, last);
+  I end = i;
+  while (i != first)
+    *--result = iter_move(--i);
+  return {end, result};
+}
+
+template<typename I, typename S, typename O>
+  requires MemoryCopyable<I, O>() && SizedSentinel<S, I>()
+std::pair<I, O>
+move_backward(I first, S last, O result)
+{
+  difference_type_t<I> n = last - first;
+  if (n > 0) {
+    result -= n;
+    std::memmove(address(result), address(first), n * sizeof(value_type_t<I>));
+  }
+  return {first + n, result};
+}
+
+
+template<typename T>
+concept bool MemorySettable()
+{
+  return Integral<T>() && is_trivially_copyable_v<T>;
+}
+
+// Returns true when the object representation of x consists of a single
+// repeated byte, which is stored in b.
+template<typename T>
+inline bool
+splat_byte(T const& x, unsigned char& b)
+{
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &x, sizeof(T));
+  for (std::size_t i = 1; i < sizeof(T); ++i)
+    if (bytes[i] != bytes[0])
+      return false;
+  b = bytes[0];
+  return true;
+}
+
+
+template<typename O, typename T>
+O
+fill_n(O first, difference_type_t<O> n, T const& value)
+{
+  for (; n > 0; --n, ++first)
+    *first = value;
+  return first;
+}
+
+template<ContiguousIterator O, typename T>
+  requires MemorySettable<value_type_t<O>>()
+O
+fill_n(O first, difference_type_t<O> n, T const& value)
+{
+  using V = value_type_t<O>;
+  if (n <= 0)
+    return first;
+  V v = value;
+  unsigned char b;
+  if (splat_byte(v, b)) {
+    std::memset(address(first), b, n * sizeof(V));
+    return first + n;
+  }
+  V* p = address(first);
+  for (difference_type_t<O> i = 0; i < n; ++i)
+    p[i] = v;
+  return first + n;
+}
+
+
+template<typename O, typename S, typename T>
+O
+fill(O first, S last, T const& value)
+{
+  for (; first != last; ++first)
+    *first = value;
+  return first;
+}
+
+template<ContiguousIterator O, SizedSentinel<O> S, typename T>
+  requires MemorySettable<value_type_t<O>>()
+inline O
+fill(O first, S last, T const& value)
+{
+  return impl::fill_n(first, last - first, value);
+}
+
+} // namespace impl
+
+
+// Copy
+//
+// NOTE: The TS returns a tagged pair of the input and output positions.
+// We return a std::pair.
+
+template<InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+  requires IndirectlyCopyable<I, O>()
+inline std::pair<I, O>
+copy(I first, S last, O result)
+{
+  return impl::copy(first, last, result);
+}
+
+template<InputRange R, WeaklyIncrementable O>
+  requires IndirectlyCopyable<iterator_t<R>, O>()
+inline std::pair<iterator_t<R>, O>
+copy(R&& range, O result)
+{
+  return impl::copy(begin(range), end(range), result);
+}
+
+
+// Copy n
+
+template<InputIterator I, WeaklyIncrementable O>
+  requires IndirectlyCopyable<I, O>()
+inline std::pair<I, O>
+copy_n(I first, difference_type_t<I> n, O result)
+{
+  return impl::copy_n(first, n, result);
+}
+
+
+// Move
+
+template<InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+  requires IndirectlyMovable<I, O>()
+inline std::pair<I, O>
+move(I first, S last, O result)
+{
+  return impl::move(first, last, result);
+}
+
+template<InputRange R, WeaklyIncrementable O>
+  requires IndirectlyMovable<iterator_t<R>, O>()
+inline std::pair<iterator_t<R>, O>
+move(R&& range, O result)
+{
+  return impl::move(begin(range), end(range), result);
+}
+
+
+// Move backward
+
+template<BidirectionalIterator I1, Sentinel<I1> S1, BidirectionalIterator I2>
+  requires IndirectlyMovable<I1, I2>()
+inline std::pair<I1, I2>
+move_backward(I1 first, S1 last, I2 result)
+{
+  return impl::move_backward(first, last, result);
+}
+
+template<BidirectionalRange R, BidirectionalIterator I>
+  requires IndirectlyMovable<iterator_t<R>, I>()
+inline std::pair<iterator_t<R>, I>
+move_backward(R&& range, I result)
+{
+  return impl::move_backward(begin(range), end(range), result);
+}
+
+
+// Fill
+
+template<typename T, OutputIterator<T const&> O, Sentinel<O> S>
+inline O
+fill(O first, S last, T const& value)
+{
+  return impl::fill(first, last, value);
+}
+
+template<typename T, OutputRange<T const&> R>
+inline iterator_t<R>
+fill(R&& range, T const& value)
+{
+  return impl::fill(begin(range), end(range), value);
+}
+
+
+// Fill n
+
+template<typename T, OutputIterator<T const&> O>
+inline O
+fill_n(O first, difference_type_t<O> n, T const& value)
+{
+  return impl::fill_n(first, n, value);
+}
+
+
+// Parallel kernels
+//
+// The parallel algorithms split random access sequences into pieces
+// that run on the policy's thread pool (see parallel_for). Other
+// sequences, short sequences, and the sequenced policy run on the
+// calling thread.
+//
+// Parallel searches share the position of the leftmost match found so
+// far. Each piece is searched a block at a time, and is abandoned once
+// a match is known to lie to its left.
+
+namespace impl
+{
+
+constexpr std::ptrdiff_t parallel_search_block = 4096;
+
+template<typename I, typename S, typename F>
+inline I
+par_search(thread_pool*, I first, S last, F search)
+{
+  return search(first, last);
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, typename F>
+I
+par_search(thread_pool* pool, I first, S last, F search)
+{
+  using D = difference_type_t<I>;
+  D n = last - first;
+  if (!pool || n <= parallel_grain)
+    return search(first, first + n);
+  std::atomic<D> found(n);
+  parallel_for(*pool, n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+    while (b < e && b < found.load(std::memory_order_relaxed)) {
+      std::ptrdiff_t m = e - b > parallel_search_block ? b + parallel_search_block : e;
+      D k = search(first + b, first + m) - first;
+      if (k != m) {
+        D f = found.load(std::memory_order_relaxed);
+        while (k < f && !found.compare_exchange_weak(f, k))
+          ;
+        return;
+      }
+      b = m;
+    }
+  });
+  return first + found.load();
+}
+
+template<typename R, typename F>
+inline iterator_t<R>
+par_search(thread_pool* pool, R& range, F search)
+{
+  return impl::search_range(range, [pool, &search](auto first, auto last) {
+    return impl::par_search(pool, first, last, search);
+  });
+}
+
+
+template<typename I, typename S, typename P>
+inline I
+par_find_if(thread_pool* pool, I first, S last, P pred)
+{
+  return impl::par_search(pool, first, last, [&pred](auto i, auto j) {
+    return impl::find_if(i, j, pred);
+  });
+}
+
+template<typename R, typename P>
+inline iterator_t<R>
+par_find_if(thread_pool* pool, R& range, P pred)
+{
+  return impl::par_search(pool, range, [&pred](auto i, auto j) {
+    return impl::find_if(i, j, pred);
+  });
+}
+
+
+template<typename I, typename S, typename O>
+inline std::pair<I, O>
+par_copy(thread_pool*, I first, S last, O result)
+{
+  return impl::copy(first, last, result);
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, RandomAccessIterator O>
+std::pair<I, O>
+par_copy(thread_pool* pool, I first, S last, O result)
+{
+  difference_type_t<I> n = last - first;
+  if (!pool || n <= parallel_grain)
+    return impl::copy(first, first + n, result);
+  parallel_for(*pool, n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+    impl::copy(first + b, first + e, result + b);
+  });
+  return {first + n, result + n};
+}
+
+
+template<typename I, typename O>
+inline std::pair<I, O>
+par_copy_n(thread_pool*, I first, difference_type_t<I> n, O result)
+{
+  return impl::copy_n(first, n, result);
+}
+
+template<RandomAccessIterator I, RandomAccessIterator O>
+inline std::pair<I, O>
+par_copy_n(thread_pool* pool, I first, difference_type_t<I> n, O result)
+{
+  if (n <= 0)
+    return {first, result};
+  return impl::par_copy(pool, first, first + n, result);
+}
+
+
+template<typename I, typename S, typename O>
+inline std::pair<I, O>
+par_move(thread_pool*, I first, S last, O result)
+{
+  return impl::move(first, last, result);
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, RandomAccessIterator O>
+std::pair<I, O>
+par_move(thread_pool* pool, I first, S last, O result)
+{
+  difference_type_t<I> n = last - first;
+  if (!pool || n <= parallel_grain)
+    return impl::move(first, first + n, result);
+  parallel_for(*pool, n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+    impl::move(first + b, first + e, result + b);
+  });
+  return {first + n, result + n};
+}
+
+
+template<typename O, typename S, typename T>
+inline O
+par_fill(thread_pool*, O first, S last, T const& value)
+{
+  return impl::fill(first, last, value);
+}
+
+template<RandomAccessIterator O, SizedSentinel<O> S, typename T>
+O
+par_fill(thread_pool* pool, O first, S last, T const& value)
+{
+  difference_type_t<O> n = last - first;
+  if (!pool || n <= parallel_grain)
+    return impl::fill_n(first, n, value);
+  parallel_for(*pool, n, [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+    impl::fill_n(first + b, e - b, value);
+  });
+  return first + n;
+}
+
+
+template<typename O, typename T>
+inline O
+par_fill_n(thread_pool*, O first, difference_type_t<O> n, T const& value)
+{
+  return impl::fill_n(first, n, value);
+}
+
+template<RandomAccessIterator O, typename T>
+inline O
+par_fill_n(thread_pool* pool, O first, difference_type_t<O> n, T const& value)
+{
+  if (n <= 0)
+    return first;
+  return impl::par_fill(pool, first, first + n, value);
+}
+
+} // namespace impl
+
+
+// Find (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename T>
+  requires IndirectRelation<equal_to<>, I, T const*>()
+inline I
+find(E&& policy, I first, S last, T const& value)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_search(pool, first, last, [&value](auto i, auto j) {
+    return impl::find(i, j, value);
+  });
+}
+
+template<ExecutionPolicy E, InputRange R, typename T>
+  requires IndirectRelation<equal_to<>, iterator_t<R>, T const*>()
+inline iterator_t<R>
+find(E&& policy, R&& range, T const& value)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_search(pool, range, [&value](auto i, auto j) {
+    return impl::find(i, j, value);
+  });
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename T, typename X>
+  requires IndirectRelation<equal_to<>, projected<I, X>, T const*>()
+inline I
+find(E&& policy, I first, S last, T const& value, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, first, last, [&](auto&& x) -> bool {
+    return stl::invoke(proj, x) == value;
+  });
+}
+
+template<ExecutionPolicy E, InputRange R, typename T, typename X>
+  requires IndirectRelation<equal_to<>, projected<iterator_t<R>, X>, T const*>()
+inline iterator_t<R>
+find(E&& policy, R&& range, T const& value, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, range, [&](auto&& x) -> bool {
+    return stl::invoke(proj, x) == value;
+  });
+}
+
+
+// Find if (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline I
+find_if(E&& policy, I first, S last, P pred)
+{
+  return impl::par_find_if(impl::policy_pool(policy), first, last, pred);
+}
+
+template<ExecutionPolicy E, InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline iterator_t<R>
+find_if(E&& policy, R&& range, P pred)
+{
+  return impl::par_find_if(impl::policy_pool(policy), range, pred);
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline I
+find_if(E&& policy, I first, S last, P pred, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, first, last, [&](auto&& x) -> bool {
+    return stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+template<ExecutionPolicy E, InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline iterator_t<R>
+find_if(E&& policy, R&& range, P pred, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, range, [&](auto&& x) -> bool {
+    return stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+
+// Find if not (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline I
+find_if_not(E&& policy, I first, S last, P pred)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, first, last, [&pred](auto&& x) -> bool {
+    return !stl::invoke(pred, x);
+  });
+}
+
+template<ExecutionPolicy E, InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline iterator_t<R>
+find_if_not(E&& policy, R&& range, P pred)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, range, [&pred](auto&& x) -> bool {
+    return !stl::invoke(pred, x);
+  });
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline I
+find_if_not(E&& policy, I first, S last, P pred, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, first, last, [&](auto&& x) -> bool {
+    return !stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+template<ExecutionPolicy E, InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline iterator_t<R>
+find_if_not(E&& policy, R&& range, P pred, X proj)
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::par_find_if(pool, range, [&](auto&& x) -> bool {
+    return !stl::invoke(pred, stl::invoke(proj, x));
+  });
+}
+
+
+// All of (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline bool
+all_of(E&& policy, I first, S last, P pred)
+{
+  return stl::find_if_not(policy, first, last, pred) == last;
+}
+
+template<ExecutionPolicy E, InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline bool
+all_of(E&& policy, R&& range, P pred)
+{
+  return stl::find_if_not(policy, range, pred) == end(range);
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline bool
+all_of(E&& policy, I first, S last, P pred, X proj)
+{
+  return stl::find_if_not(policy, first, last, pred, proj) == last;
+}
+
+template<ExecutionPolicy E, InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline bool
+all_of(E&& policy, R&& range, P pred, X proj)
+{
+  return stl::find_if_not(policy, range, pred, proj) == end(range);
+}
+
+
+// Any of (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline bool
+any_of(E&& policy, I first, S last, P pred)
+{
+  return stl::find_if(policy, first, last, pred) != last;
+}
+
+template<ExecutionPolicy E, InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline bool
+any_of(E&& policy, R&& range, P pred)
+{
+  return stl::find_if(policy, range, pred) != end(range);
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline bool
+any_of(E&& policy, I first, S last, P pred, X proj)
+{
+  return stl::find_if(policy, first, last, pred, proj) != last;
+}
+
+template<ExecutionPolicy E, InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline bool
+any_of(E&& policy, R&& range, P pred, X proj)
+{
+  return stl::find_if(policy, range, pred, proj) != end(range);
+}
+
+
+// None of (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, IndirectPredicate<I> P>
+inline bool
+none_of(E&& policy, I first, S last, P pred)
+{
+  return stl::find_if(policy, first, last, pred) == last;
+}
+
+template<ExecutionPolicy E, InputRange R, IndirectPredicate<iterator_t<R>> P>
+inline bool
+none_of(E&& policy, R&& range, P pred)
+{
+  return stl::find_if(policy, range, pred) == end(range);
+}
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename P, typename X>
+  requires IndirectPredicate<P, projected<I, X>>()
+inline bool
+none_of(E&& policy, I first, S last, P pred, X proj)
+{
+  return stl::find_if(policy, first, last, pred, proj) == last;
+}
+
+template<ExecutionPolicy E, InputRange R, typename P, typename X>
+  requires IndirectPredicate<P, projected<iterator_t<R>, X>>()
+inline bool
+none_of(E&& policy, R&& range, P pred, X proj)
+{
+  return stl::find_if(policy, range, pred, proj) == end(range);
+}
+
+
+// Copy (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+  requires IndirectlyCopyable<I, O>()
+inline std::pair<I, O>
+copy(E&& policy, I first, S last, O result)
+{
+  return impl::par_copy(impl::policy_pool(policy), first, last, result);
+}
+
+template<ExecutionPolicy E, InputRange R, WeaklyIncrementable O>
+  requires IndirectlyCopyable<iterator_t<R>, O>()
+inline std::pair<iterator_t<R>, O>
+copy(E&& policy, R&& range, O result)
+{
+  return impl::par_copy(impl::policy_pool(policy), begin(range), end(range), result);
+}
+
+template<ExecutionPolicy E, InputIterator I, WeaklyIncrementable O>
+  requires IndirectlyCopyable<I, O>()
+inline std::pair<I, O>
+copy_n(E&& policy, I first, difference_type_t<I> n, O result)
+{
+  return impl::par_copy_n(impl::policy_pool(policy), first, n, result);
+}
+
+
+// Move (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
+  requires IndirectlyMovable<I, O>()
+inline std::pair<I, O>
+move(E&& policy, I first, S last, O result)
+{
+  return impl::par_move(impl::policy_pool(policy), first, last, result);
+}
+
+template<ExecutionPolicy E, InputRange R, WeaklyIncrementable O>
+  requires IndirectlyMovable<iterator_t<R>, O>()
+inline std::pair<iterator_t<R>, O>
+move(E&& policy, R&& range, O result)
+{
+  return impl::par_move(impl::policy_pool(policy), begin(range), end(range), result);
+}
+
+
+// Fill (parallel)
+
+template<ExecutionPolicy E, typename T, OutputIterator<T const&> O, Sentinel<O> S>
+inline O
+fill(E&& policy, O first, S last, T const& value)
+{
+  return impl::par_fill(impl::policy_pool(policy), first, last, value);
+}
+
+template<ExecutionPolicy E, typename T, OutputRange<T const&> R>
+inline iterator_t<R>
+fill(E&& policy, R&& range, T const& value)
+{
+  return impl::par_fill(impl::policy_pool(policy), begin(range), end(range), value);
+}
+
+template<ExecutionPolicy E, typename T, OutputIterator<T const&> O>
+inline O
+fill_n(E&& policy, O first, difference_type_t<O> n, T const& value)
+{
+  return impl::par_fill_n(impl::policy_pool(policy), first, n, value);
+}
+
+
+// Sort kernels
+//
+// Sorting is pattern-defeating quicksort. Partitions smaller than
+// sort_insertion_threshold are insertion sorted. Pivots are the median
+// of three, or the pseudo-median of nine for larger partitions. When
+// a partition is badly unbalanced, some elements are swapped to break
+// up the pattern that caused it; after log2(n) bad partitions, the
+// rest of the sequence is heap sorted, which bounds the worst case at
+// O(n log n). A partition that needed no swaps is finished off with an
+// insertion sort that gives up after a few moves, making sorted and
+// nearly sorted inputs linear.
+//
+// When the (projected) key is arithmetic, comparisons are cheap and
+// partitioning is branch-free: a block of elements is compared and
+// the offsets of misplaced elements are recorded, and then swapped in
+// bulk.
+
+namespace impl
+{
+
+constexpr std::ptrdiff_t sort_insertion_threshold = 24;
+constexpr std::ptrdiff_t sort_ninther_threshold = 128;
+constexpr std::ptrdiff_t sort_partial_insertion_limit = 8;
+constexpr std::ptrdiff_t sort_block_size = 64;
+
+
+template<typename I>
+inline void
+iter_swap(I a, I b)
+{
+  using std::swap;
+  swap(*a, *b);
+}
+
+
+template<typename I, typename C, typename P>
+inline void
+sort2(I a, I b, C& comp, P& proj)
+{
+  if (stl::invoke(comp, stl::invoke(proj, *b), stl::invoke(proj, *a)))
+    impl::iter_swap(a, b);
+}
+
+template<typename I, typename C, typename P>
+inline void
+sort3(I a, I b, I c, C& comp, P& proj)
+{
+  sort2(a, b, comp, proj);
+  sort2(b, c, comp, proj);
+  sort2(a, b, comp, proj);
+}
+
+
+template<typename I, typename C, typename P>
+void
+insertion_sort(I first, I last, C& comp, P& proj)
+{
+  if (first == last)
+    return;
+  for (I i = first + 1; i != last; ++i) {
+    I j = i;
+    I k = i - 1;
+    if (stl::invoke(comp, stl::invoke(proj, *j), stl::invoke(proj, *k))) {
+      value_type_t<I> tmp = iter_move(j);
+      do {
+        *j-- = iter_move(k);
+      } while (j != first &&
+               stl::invoke(comp, stl::invoke(proj, tmp), stl::invoke(proj, *--k)));
+      *j = std::move(tmp);
+    }
+  }
+}
+
+// Requires that *(first - 1) is not greater than any element in
+// [first, last).
+template<typename I, typename C, typename P>
+void
+unguarded_insertion_sort(I first, I last, C& comp, P& proj)
+{
+  if (first == last)
+    return;
+  for (I i = first + 1; i != last; ++i) {
+    I j = i;
+    I k = i - 1;
+    if (stl::invoke(comp, stl::invoke(proj, *j), stl::invoke(proj, *k))) {
+      value_type_t<I> tmp = iter_move(j);
+      do {
+        *j-- = iter_move(k);
+      } while (stl::invoke(comp, stl::invoke(proj, tmp), stl::invoke(proj, *--k)));
+      *j = std::move(tmp);
+    }
+  }
+}
+
+// Insertion sort that gives up after moving sort_partial_insertion_limit
+// elements. Returns true if the sequence was sorted.
+template<typename I, typename C, typename P>
+bool
+partial_insertion_sort(I first, I last, C& comp, P& proj)
+{
+  if (first == last)
+    return true;
+  std::ptrdiff_t moves = 0;
+  for (I i = first + 1; i != last; ++i) {
+    I j = i;
+    I k = i - 1;
+    if (stl::invoke(comp, stl::invoke(proj, *j), stl::invoke(proj, *k))) {
+      value_type_t<I> tmp = iter_move(j);
+      do {
+        *j-- = iter_move(k);
+      } while (j != first &&
+               stl::invoke(comp, stl::invoke(proj, tmp), stl::invoke(proj, *--k)));
+      *j = std::move(tmp);
+      moves += i - j;
+    }
+    if (moves > sort_partial_insertion_limit)
+      return false;
+  }
+  return true;
+}
+
+
+template<typename I, typename C, typename P>
+void
+sift_down(I first, difference_type_t<I> n, difference_type_t<I> i,
+          C& comp, P& proj)
+{
+  value_type_t<I> tmp = iter_move(first + i);
+  while (true) {
+    difference_type_t<I> child = 2 * i + 1;
+    if (child >= n)
+      break;
+    if (child + 1 < n && stl::invoke(comp, stl::invoke(proj, first[child]),
+                                     stl::invoke(proj, first[child + 1])))
+      ++child;
+    if (!stl::invoke(comp, stl::invoke(proj, tmp), stl::invoke(proj, first[child])))
+      break;
+    first[i] = iter_move(first + child);
+    i = child;
+  }
+  first[i] = std::move(tmp);
+}
+
+template<typename I, typename C, typename P>
+void
+heap_sort(I first, I last, C& comp, P& proj)
+{
+  difference_type_t<I> n = last - first;
+  for (difference_type_t<I> i = n / 2; i > 0; --i)
+    sift_down(first, n, i - 1, comp, proj);
+  for (difference_type_t<I> m = n - 1; m > 0; --m) {
+    impl::iter_swap(first, first + m);
+    sift_down(first, m, difference_type_t<I>(0), comp, proj);
+  }
+}
+
+
+// Partitions [first, last) around the pivot *first, placing elements
+// equal to the pivot on the left. Used when the pivot is equal to the
+// element before the partition, so that runs of equal elements are
+// consumed in linear time. Returns the position of the pivot.
+template<typename I, typename C, typename P>
+I
+partition_left(I first, I last, C& comp, P& proj)
+{
+  value_type_t<I> pivot = iter_move(first);
+  I i = first;
+  I j = last;
+  while (stl::invoke(comp, stl::invoke(proj, pivot), stl::invoke(proj, *--j)))
+    ;
+  if (j + 1 == last)
+    while (i < j && !stl::invoke(comp, stl::invoke(proj, pivot), stl::invoke(proj, *++i)))
+      ;
+  else
+    while (!stl::invoke(comp, stl::invoke(proj, pivot), stl::invoke(proj, *++i)))
+      ;
+  while (i < j) {
+    impl::iter_swap(i, j);
+    while (stl::invoke(comp, stl::invoke(proj, pivot), stl::invoke(proj, *--j)))
+      ;
+    while (!stl::invoke(comp, stl::invoke(proj, pivot), stl::invoke(proj, *++i)))
+      ;
+  }
+  *first = iter_move(j);
+  *j = std::move(pivot);
+  return j;
+}
+
+
+// Partitions [first, last) around the pivot *first, placing elements
+// equal to the pivot on the right. Returns the position of the pivot
+// and whether the sequence was already partitioned.
+template<typename I, typename C, typename P>
+std::pair<I, bool>
+partition_right(I first, I last, C& comp, P& proj)
+{
+  value_type_t<I> pivot = iter_move(first);
+  I i = first;
+  I j = last;
+  while (stl::invoke(comp, stl::invoke(proj, *++i), stl::invoke(proj, pivot)))
+    ;
+  if (i - 1 == first)
+    while (i < j && !stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot)))
+      ;
+  else
+    while (!stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot)))
+      ;
+  bool partitioned = i >= j;
+  while (i < j) {
+    impl::iter_swap(i, j);
+    while (stl::invoke(comp, stl::invoke(proj, *++i), stl::invoke(proj, pivot)))
+      ;
+    while (!stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot)))
+      ;
+  }
+  I pos = i - 1;
+  *first = iter_move(pos);
+  *pos = std::move(pivot);
+  return {pos, partitioned};
+}
+
+
+// Exchanges the elements at the recorded offsets from the left and
+// right of the partition. When the counts differ, a cyclic permutation
+// needs fewer moves than pairwise swaps.
+template<typename I>
+void
+swap_offsets(I first, I last, unsigned char const* left,
+             unsigned char const* right, std::ptrdiff_t n, bool use_swaps)
+{
+  if (use_swaps) {
+    for (std::ptrdiff_t i = 0; i < n; ++i)
+      impl::iter_swap(first + left[i], last - right[i]);
+  } else if (n > 0) {
+    I l = first + left[0];
+    I r = last - right[0];
+    value_type_t<I> tmp = iter_move(l);
+    *l = iter_move(r);
+    for (std::ptrdiff_t i = 1; i < n; ++i) {
+      l = first + left[i];
+      *r = iter_move(l);
+      r = last - right[i];
+      *l = iter_move(r);
+    }
+    *r = std::move(tmp);
+  }
+}
+
+template<typename I, typename C, typename P>
+std::pair<I, bool>
+partition_right_branchless(I first, I last, C& comp, P& proj)
+{
+  value_type_t<I> pivot = iter_move(first);
+  I i = first;
+  I j = last;
+  while (stl::invoke(comp, stl::invoke(proj, *++i), stl::invoke(proj, pivot)))
+    ;
+  if (i - 1 == first)
+    while (i < j && !stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot)))
+      ;
+  else
+    while (!stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot)))
+      ;
+  bool partitioned = i >= j;
+  if (!partitioned) {
+    impl::iter_swap(i, j);
+    ++i;
+
+    unsigned char left[sort_block_size];
+    unsigned char right[sort_block_size];
+    I left_base = i;
+    I right_base = j;
+    std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (i < j) {
+      // Fill whichever offset buffers are empty. Near the end, split
+      // the remaining unknown elements between them.
+      std::ptrdiff_t unknown = j - i;
+      std::ptrdiff_t left_split =
+        num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+      std::ptrdiff_t right_split = num_r == 0 ? unknown - left_split : 0;
+      if (left_split > sort_block_size)
+        left_split = sort_block_size;
+      if (right_split > sort_block_size)
+        right_split = sort_block_size;
+
+      for (std::ptrdiff_t k = 0; k < left_split; ++k) {
+        left[num_l] = static_cast<unsigned char>(k);
+        num_l += !stl::invoke(comp, stl::invoke(proj, *i), stl::invoke(proj, pivot));
+        ++i;
+      }
+      for (std::ptrdiff_t k = 0; k < right_split;) {
+        right[num_r] = static_cast<unsigned char>(++k);
+        num_r += stl::invoke(comp, stl::invoke(proj, *--j), stl::invoke(proj, pivot));
+      }
+
+      std::ptrdiff_t n = num_l < num_r ? num_l : num_r;
+      swap_offsets(left_base, right_base, left + start_l, right + start_r,
+                   n, num_l == num_r);
+      num_l -= n;
+      num_r -= n;
+      start_l += n;
+      start_r += n;
+      if (num_l == 0) {
+        start_l = 0;
+        left_base = i;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        right_base = j;
+      }
+    }
+
+    // Move the remaining misplaced elements to the middle.
+    if (num_l) {
+      while (num_l--)
+        impl::iter_swap(left_base + left[start_l + num_l], --j);
+      i = j;
+    }
+    if (num_r) {
+      while (num_r--)
+        impl::iter_swap(right_base - right[start_r + num_r], i), ++i;
+      j = i;
+    }
+  }
+  I pos = i - 1;
+  *first = iter_move(pos);
+  *pos = std::move(pivot);
+  return {pos, partitioned};
+}
+
+
+template<typename I, typename C, typename P>
+inline std::pair<I, bool>
+sort_partition(I first, I last, C& comp, P& proj, false_type)
+{
+  return partition_right(first, last, comp, proj);
+}
+
+template<typename I, typename C, typename P>
+inline std::pair<I, bool>
+sort_partition(I first, I last, C& comp, P& proj, true_type)
+{
+  return partition_right_branchless(first, last, comp, proj);
+}
+
+
+template<typename I, typename C, typename P, typename B>
+void
+sort_loop(I first, I last, C& comp, P& proj, int bad, bool leftmost, B branchless)
+{
+  using D = difference_type_t<I>;
+  while (true) {
+    D size = last - first;
+    if (size < sort_insertion_threshold) {
+      if (leftmost)
+        insertion_sort(first, last, comp, proj);
+      else
+        unguarded_insertion_sort(first, last, comp, proj);
+      return;
+    }
+
+    // Move the pivot to the front.
+    D half = size / 2;
+    if (size > sort_ninther_threshold) {
+      sort3(first, first + half, last - 1, comp, proj);
+      sort3(first + 1, first + (half - 1), last - 2, comp, proj);
+      sort3(first + 2, first + (half + 1), last - 3, comp, proj);
+      sort3(first + (half - 1), first + half, first + (half + 1), comp, proj);
+      impl::iter_swap(first, first + half);
+    } else {
+      sort3(first + half, first, last - 1, comp, proj);
+    }
+
+    // If the pivot equals the element before this partition, everything
+    // equal to it is already in place.
+    if (!leftmost && !stl::invoke(comp, stl::invoke(proj, *(first - 1)),
+                                  stl::invoke(proj, *first))) {
+      first = partition_left(first, last, comp, proj) + 1;
+      continue;
+    }
+
+    std::pair<I, bool> part = sort_partition(first, last, comp, proj, branchless);
+    I pivot = part.first;
+    D l = pivot - first;
+    D r = last - (pivot + 1);
+
+    if (l < size / 8 || r < size / 8) {
+      if (--bad == 0) {
+        heap_sort(first, last, comp, proj);
+        return;
+      }
+      if (l >= sort_insertion_threshold) {
+        impl::iter_swap(first, first + l / 4);
+        impl::iter_swap(pivot - 1, pivot - l / 4);
+        if (l > sort_ninther_threshold) {
+          impl::iter_swap(first + 1, first + (l / 4 + 1));
+          impl::iter_swap(first + 2, first + (l / 4 + 2));
+          impl::iter_swap(pivot - 2, pivot - (l / 4 + 1));
+          impl::iter_swap(pivot - 3, pivot - (l / 4 + 2));
+        }
+      }
+      if (r >= sort_insertion_threshold) {
+        impl::iter_swap(pivot + 1, pivot + (1 + r / 4));
+        impl::iter_swap(last - 1, last - r / 4);
+        if (r > sort_ninther_threshold) {
+          impl::iter_swap(pivot + 2, pivot + (2 + r / 4));
+          impl::iter_swap(pivot + 3, pivot + (3 + r / 4));
+          impl::iter_swap(last - 2, last - (1 + r / 4));
+          impl::iter_swap(last - 3, last - (2 + r / 4));
+        }
+      }
+    } else if (part.second &&
+               partial_insertion_sort(first, pivot, comp, proj) &&
+               partial_insertion_sort(pivot + 1, last, comp, proj)) {
+      return;
+    }
+
+    // Recurse on the left and loop on the right.
+    sort_loop(first, pivot, comp, proj, bad, leftmost, branchless);
+    first = pivot + 1;
+    leftmost = false;
+  }
+}
+
+
+template<typename I, typename P>
+using sort_key_t = decay_t<invoke_result_t<P&, reference_t<I>>>;
+
+template<typename I, typename C, typename P>
+void
+sort(I first, I last, C& comp, P& proj)
+{
+  difference_type_t<I> n = last - first;
+  int bad = 1;
+  while (n >>= 1)
+    ++bad;
+  boolean_constant<is_arithmetic_v<sort_key_t<I, P>>> branchless;
+  sort_loop(first, last, comp, proj, bad, true, branchless);
+}
+
+} // namespace impl
+
+
+// Sort
+
+template<RandomAccessIterator I, Sentinel<I> S, typename R = less<>,
+         typename P = identity_fn>
+  requires Sortable<I, R, P>()
+I
+sort(I first, S last, R comp = R{}, P proj = P{})
+{
+  I end = stl::next(first, last);
+  impl::sort(first, end, comp, proj);
+  return end;
+}
+
+template<RandomAccessRange Rng, typename R = less<>, typename P = identity_fn>
+  requires Sortable<iterator_t<Rng>, R, P>()
+inline iterator_t<Rng>
+sort(Rng&& range, R comp = R{}, P proj = P{})
+{
+  return stl::sort(begin(range), end(range), comp, proj);
+}
+
+
+// Radix sort kernels
+//
+// Elements are sorted by an integral key, least significant byte first,
+// by scattering them between the sequence and a buffer of the same size.
+// The byte histograms for every pass are computed in a single read of
+// the keys. A pass is skipped when all keys have the same byte in that
+// position, so keys with a small range take fewer passes.
+
+namespace impl
+{
+
+constexpr std::ptrdiff_t radix_sort_threshold = 64;
+
+
+// Maps keys onto unsigned integers of the same width that preserve
+// their order. For signed keys, flipping the sign bit puts negative
+// values first.
+template<Integral K>
+inline make_unsigned_t<K>
+radix_key(K k)
+{
+  return k;
+}
+
+template<SignedIntegral K>
+inline make_unsigned_t<K>
+radix_key(K k)
+{
+  using U = make_unsigned_t<K>;
+  return static_cast<U>(k) ^ (U(1) << (8 * sizeof(K) - 1));
+}
+
+// Any integral type except bool can be a key.
+template<typename K>
+concept bool RadixKey()
+{
+  return Integral<K>() && !SameAs<K, bool>();
+}
+
+template<typename I, typename P>
+using radix_key_t = decltype(radix_key(std::declval<sort_key_t<I, P>>()));
+
+
+template<typename I, typename P>
+struct radix_plan
+{
+  static constexpr int bytes = sizeof(radix_key_t<I, P>);
+
+  std::size_t counts[bytes][256];
+  int digits[bytes];
+  int passes;
+};
+
+template<typename I, typename P>
+void
+radix_count(I first, std::ptrdiff_t n, radix_plan<I, P>& plan, P& proj)
+{
+  constexpr int bytes = radix_plan<I, P>::bytes;
+  std::memset(plan.counts, 0, sizeof(plan.counts));
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    auto k = radix_key(stl::invoke(proj, first[i]));
+    for (int d = 0; d < bytes; ++d, k >>= 8)
+      ++plan.counts[d][k & 0xff];
+  }
+  auto k0 = radix_key(stl::invoke(proj, first[0]));
+  plan.passes = 0;
+  for (int d = 0; d < bytes; ++d)
+    if (plan.counts[d][(k0 >> (8 * d)) & 0xff] != std::size_t(n))
+      plan.digits[plan.passes++] = d;
+}
+
+
+template<typename I, typename O, typename P>
+void
+radix_scatter(I in, std::ptrdiff_t n, O out, std::size_t const* count,
+              int digit, P& proj)
+{
+  std::size_t offsets[256];
+  std::size_t sum = 0;
+  for (int b = 0; b < 256; ++b) {
+    offsets[b] = sum;
+    sum += count[b];
+  }
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    std::size_t b = (radix_key(stl::invoke(proj, in[i])) >> (8 * digit)) & 0xff;
+    out[offsets[b]++] = iter_move(in + i);
+  }
+}
+
+
+// Runs the planned passes, alternating between the sequence and the
+// buffer. When in_buffer is true, the elements start out in the buffer.
+template<typename I, typename J, typename P>
+void
+radix_passes(I first, std::ptrdiff_t n, J buf, bool in_buffer,
+             radix_plan<I, P> const& plan, P& proj)
+{
+  for (int p = 0; p < plan.passes; ++p) {
+    int d = plan.digits[p];
+    if (in_buffer)
+      radix_scatter(buf, n, first, plan.counts[d], d, proj);
+    else
+      radix_scatter(first, n, buf, plan.counts[d], d, proj);
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer)
+    impl::move(buf, buf + n, first);
+}
+
+
+// Uninitialized storage for n objects of type T.
+template<typename T>
+struct temporary_buffer
+{
+  explicit temporary_buffer(std::ptrdiff_t n)
+    : data(std::allocator<T>().allocate(n)), size(n)
+  { }
+
+  temporary_buffer(temporary_buffer const&) = delete;
+  temporary_buffer& operator=(temporary_buffer const&) = delete;
+
+  ~temporary_buffer() { std::allocator<T>().deallocate(data, size); }
+
+  T* data;
+  std::ptrdiff_t size;
+};
+
+
+// Calls f(buf, in_buffer) with a buffer for the n elements starting at
+// first. The elements are moved into a temporary vector, which becomes
+// the buffer, so in_buffer is true: they start out in the buffer.
+template<typename I, typename F>
+void
+with_buffer(I first, std::ptrdiff_t n, F f)
+{
+  std::vector<value_type_t<I>> buf;
+  buf.reserve(n);
+  for (std::ptrdiff_t i = 0; i < n; ++i)
+    buf.emplace_back(iter_move(first + i));
+  f(buf.begin(), true);
+}
+
+// Trivially copyable elements do not need to be initialized before
+// they are written, so the buffer is uninitialized storage.
+template<typename I, typename F>
+  requires is_trivially_copyable_v<value_type_t<I>>
+void
+with_buffer(I first, std::ptrdiff_t n, F f)
+{
+  temporary_buffer<value_type_t<I>> buf(n);
+  f(buf.data, false);
+}
+
+
+template<typename I, typename P>
+void
+radix_sort(I first, std::ptrdiff_t n, radix_plan<I, P> const& plan, P& proj)
+{
+  impl::with_buffer(first, n, [&](auto buf, bool in_buffer) {
+    impl::radix_passes(first, n, buf, in_buffer, plan, proj);
+  });
+}
+
+} // namespace impl
+
+
+// Radix sort
+//
+// Sorts a sequence by an integral key in linear time. The sort is
+// stable. A buffer of at least the size of the range may be supplied;
+// otherwise, or when the buffer is too small, one is allocated when
+// needed.
+
+template<RandomAccessRange R, typename P = identity_fn>
+  requires Permutable<iterator_t<R>>() &&
+           impl::RadixKey<impl::sort_key_t<iterator_t<R>, P>>()
+iterator_t<R>
+radix_sort(R&& range, P proj = P{})
+{
+  using I = iterator_t<R>;
+  I first = begin(range);
+  I last = stl::next(first, end(range));
+  std::ptrdiff_t n = last - first;
+  if (n < impl::radix_sort_threshold) {
+    less<> comp;
+    impl::insertion_sort(first, last, comp, proj);
+    return last;
+  }
+  impl::radix_plan<I, P> plan;
+  impl::radix_count(first, n, plan, proj);
+  if (plan.passes != 0)
+    impl::radix_sort(first, n, plan, proj);
+  return last;
+}
+
+template<RandomAccessRange R, RandomAccessRange B, typename P = identity_fn>
+  requires SizedRange<B>() && Permutable<iterator_t<R>>() &&
+           impl::RadixKey<impl::sort_key_t<iterator_t<R>, P>>() &&
+           IndirectlyMovable<iterator_t<R>, iterator_t<B>>() &&
+           IndirectlyMovable<iterator_t<B>, iterator_t<R>>()
+iterator_t<R>
+radix_sort(R&& range, B&& buffer, P proj = P{})
+{
+  using I = iterator_t<R>;
+  I first = begin(range);
+  I last = stl::next(first, end(range));
+  std::ptrdiff_t n = last - first;
+  if (n < impl::radix_sort_threshold) {
+    less<> comp;
+    impl::insertion_sort(first, last, comp, proj);
+    return last;
+  }
+  impl::radix_plan<I, P> plan;
+  impl::radix_count(first, n, plan, proj);
+  if (static_cast<std::ptrdiff_t>(stl::size(buffer)) < n)
+    impl::radix_sort(first, n, plan, proj);
+  else
+    impl::radix_passes(first, n, begin(buffer), false, plan, proj);
+  return last;
+}
+
+
+// Stable sort kernels
+//
+// Stable sorting is a bottom-up merge sort. Runs of stable_sort_run
+// elements are insertion sorted, and then merged in passes of doubling
+// width, alternating between the sequence and a buffer of the same
+// size.
+
+namespace impl
+{
+
+constexpr std::ptrdiff_t stable_sort_run = 32;
+
+// Merges [f1, l1) and [f2, l2) into out by moving. Elements of the first
+// sequence precede equal elements of the second. The choice of element
+// is written as a select rather than a branch, which mispredicts about
+// half the time on random input.
+template<typename I, typename O, typename C, typename P>
+O
+merge_move(I f1, I l1, I f2, I l2, O out, C& comp, P& proj)
+{
+  while (f1 != l1 && f2 != l2) {
+    bool b = stl::invoke(comp, stl::invoke(proj, *f2), stl::invoke(proj, *f1));
+    *out = iter_move(b ? f2 : f1);
+    f2 += b;
+    f1 += !b;
+    ++out;
+  }
+  out = impl::move(f1, l1, out).second;
+  return impl::move(f2, l2, out).second;
+}
+
+// Merges adjacent runs of width w from src into dst.
+template<typename I, typename O, typename C, typename P>
+void
+merge_pass(I src, std::ptrdiff_t n, O dst, std::ptrdiff_t w, C& comp, P& proj)
+{
+  for (std::ptrdiff_t i = 0; i < n; i += 2 * w) {
+    std::ptrdiff_t m = n - i > w ? i + w : n;
+    std::ptrdiff_t e = n - m > w ? m + w : n;
+    impl::merge_move(src + i, src + m, src + m, src + e, dst + i, comp, proj);
+  }
+}
+
+// Sorts the n elements at first, using buf as storage for another n
+// elements. When in_buffer is true, the elements start out in the buffer.
+template<typename I, typename J, typename C, typename P>
+void
+merge_sort(I first, std::ptrdiff_t n, J buf, bool in_buffer, C& comp, P& proj)
+{
+  for (std::ptrdiff_t i = 0; i < n; i += stable_sort_run) {
+    std::ptrdiff_t e = n - i > stable_sort_run ? i + stable_sort_run : n;
+    if (in_buffer)
+      impl::insertion_sort(buf + i, buf + e, comp, proj);
+    else
+      impl::insertion_sort(first + i, first + e, comp, proj);
+  }
+  for (std::ptrdiff_t w = stable_sort_run; w < n; w *= 2) {
+    if (in_buffer)
+      impl::merge_pass(buf, n, first, w, comp, proj);
+    else
+      impl::merge_pass(first, n, buf, w, comp, proj);
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer)
+    impl::move(buf, buf + n, first);
+}
+
+template<typename I, typename C, typename P>
+void
+stable_sort(I first, I last, C& comp, P& proj)
+{
+  std::ptrdiff_t n = last - first;
+  if (n <= stable_sort_run) {
+    impl::insertion_sort(first, last, comp, proj);
+    return;
+  }
+  impl::with_buffer(first, n, [&](auto buf, bool in_buffer) {
+    impl::merge_sort(first, n, buf, in_buffer, comp, proj);
+  });
+}
+
+} // namespace impl
+
+
+// Stable sort
+
+template<RandomAccessIterator I, Sentinel<I> S, typename R = less<>,
+         typename P = identity_fn>
+  requires Sortable<I, R, P>()
+I
+stable_sort(I first, S last, R comp = R{}, P proj = P{})
+{
+  I end = stl::next(first, last);
+  impl::stable_sort(first, end, comp, proj);
+  return end;
+}
+
+template<RandomAccessRange Rng, typename R = less<>, typename P = identity_fn>
+  requires Sortable<iterator_t<Rng>, R, P>()
+inline iterator_t<Rng>
+stable_sort(Rng&& range, R comp = R{}, P proj = P{})
+{
+  return stl::stable_sort(begin(range), end(range), comp, proj);
+}
+
+
+// Parallel sort kernels
+//
+// The sequence is split into one run per thread, and the runs are
+// sorted in parallel. Adjacent runs are then merged in rounds,
+// alternating between the sequence and a buffer. Every merge is cut
+// into pieces of about the same length, found by searching for where
+// the piece's first output position lies on the merge path, so that
+// each round is as parallel as the first, no matter how few runs are
+// left. Merging is stable, so the sort is stable if the runs' sort is.
+
+namespace impl
+{
+
+// Returns how many elements of [a, a + na) are among the first d
+// elements of the merge of [a, a + na) and [b, b + nb).
+template<typename I, typename C, typename P>
+std::ptrdiff_t
+merge_path(I a, std::ptrdiff_t na, I b, std::ptrdiff_t nb, std::ptrdiff_t d,
+           C& comp, P& proj)
+{
+  std::ptrdiff_t lo = d > nb ? d - nb : 0;
+  std::ptrdiff_t hi = d < na ? d : na;
+  while (lo < hi) {
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+    if (stl::invoke(comp, stl::invoke(proj, b[d - mid - 1]), stl::invoke(proj, a[mid])))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// Merges adjacent pairs of groups of w runs from src into dst, where
+// run i is [bounds[i], bounds[i + 1]). A group without a partner is
+// moved.
+template<typename I, typename O, typename C, typename P>
+void
+merge_round(thread_pool& pool, I src, O dst,
+            std::vector<std::ptrdiff_t> const& bounds, std::ptrdiff_t w,
+            C& comp, P& proj)
+{
+  std::ptrdiff_t k = bounds.size() - 1;
+  std::ptrdiff_t piece = bounds[k] / (4 * static_cast<std::ptrdiff_t>(pool.size()));
+  if (piece < parallel_grain)
+    piece = parallel_grain;
+  // Merges the output positions [d0, d1) of the runs [b, m) and [m, e).
+  auto merge = [&](std::ptrdiff_t b, std::ptrdiff_t m, std::ptrdiff_t e,
+                   std::ptrdiff_t d0, std::ptrdiff_t d1) {
+    I x = src + b;
+    I y = src + m;
+    std::ptrdiff_t i0 = merge_path(x, m - b, y, e - m, d0, comp, proj);
+    std::ptrdiff_t i1 = merge_path(x, m - b, y, e - m, d1, comp, proj);
+    impl::merge_move(x + i0, x + i1, y + (d0 - i0), y + (d1 - i1),
+                     dst + (b + d0), comp, proj);
+  };
+  task_group g(pool);
+  for (std::ptrdiff_t r = 0; r < k; r += 2 * w) {
+    std::ptrdiff_t b = bounds[r];
+    std::ptrdiff_t m = bounds[k - r > w ? r + w : k];
+    std::ptrdiff_t e = bounds[k - r > 2 * w ? r + 2 * w : k];
+    std::ptrdiff_t parts = (e - b + piece - 1) / piece;
+    for (std::ptrdiff_t p = 0; p < parts; ++p) {
+      std::ptrdiff_t d0 = (e - b) * p / parts;
+      std::ptrdiff_t d1 = (e - b) * (p + 1) / parts;
+      impl::spawn(g, [&merge, b, m, e, d0, d1]() { merge(b, m, e, d0, d1); });
+    }
+  }
+  g.wait();
+}
+
+// Sorts [first, last) by sorting runs with sort_run(f, l), and merging
+// them.
+template<typename I, typename C, typename P, typename F>
+void
+par_sort(thread_pool* pool, I first, I last, C& comp, P& proj, F sort_run)
+{
+  std::ptrdiff_t n = last - first;
+  std::ptrdiff_t k = pool ? pool->size() : 1;
+  if (k > n / parallel_grain)
+    k = n / parallel_grain;
+  if (k <= 1) {
+    sort_run(first, last);
+    return;
+  }
+  std::vector<std::ptrdiff_t> bounds(k + 1);
+  for (std::ptrdiff_t i = 0; i <= k; ++i)
+    bounds[i] = n * i / k;
+  impl::with_buffer(first, n, [&](auto buf, bool in_buffer) {
+    task_group g(*pool);
+    for (std::ptrdiff_t i = 0; i < k; ++i)
+      impl::spawn(g, [&, i]() {
+        if (in_buffer)
+          sort_run(buf + bounds[i], buf + bounds[i + 1]);
+        else
+          sort_run(first + bounds[i], first + bounds[i + 1]);
+      });
+    g.wait();
+    for (std::ptrdiff_t w = 1; w < k; w *= 2) {
+      if (in_buffer)
+        impl::merge_round(*pool, buf, first, bounds, w, comp, proj);
+      else
+        impl::merge_round(*pool, first, buf, bounds, w, comp, proj);
+      in_buffer = !in_buffer;
+    }
+    if (in_buffer)
+      impl::par_move(pool, buf, buf + n, first);
+  });
+}
+
+} // namespace impl
+
+
+// Sort (parallel)
+
+template<ExecutionPolicy E, RandomAccessIterator I, Sentinel<I> S,
+         typename R = less<>, typename P = identity_fn>
+  requires Sortable<I, R, P>()
+I
+sort(E&& policy, I first, S last, R comp = R{}, P proj = P{})
+{
+  I end = stl::next(first, last);
+  impl::par_sort(impl::policy_pool(policy), first, end, comp, proj,
+                 [&](auto f, auto l) { impl::sort(f, l, comp, proj); });
+  return end;
+}
+
+template<ExecutionPolicy E, RandomAccessRange Rng, typename R = less<>,
+         typename P = identity_fn>
+  requires Sortable<iterator_t<Rng>, R, P>()
+inline iterator_t<Rng>
+sort(E&& policy, Rng&& range, R comp = R{}, P proj = P{})
+{
+  return stl::sort(policy, begin(range), end(range), comp, proj);
+}
+
+
+// Stable sort (parallel)
+
+template<ExecutionPolicy E, RandomAccessIterator I, Sentinel<I> S,
+         typename R = less<>, typename P = identity_fn>
+  requires Sortable<I, R, P>()
+I
+stable_sort(E&& policy, I first, S last, R comp = R{}, P proj = P{})
+{
+  I end = stl::next(first, last);
+  impl::par_sort(impl::policy_pool(policy), first, end, comp, proj,
+                 [&](auto f, auto l) { impl::stable_sort(f, l, comp, proj); });
+  return end;
+}
+
+template<ExecutionPolicy E, RandomAccessRange Rng, typename R = less<>,
+         typename P = identity_fn>
+  requires Sortable<iterator_t<Rng>, R, P>()
+inline iterator_t<Rng>
+stable_sort(E&& policy, Rng&& range, R comp = R{}, P proj = P{})
+{
+  return stl::stable_sort(policy, begin(range), end(range), comp, proj);
+}
+
+
+// Binary search kernels
+//
+// A search for the partition point of a forward sequence halves the
+// count and advances to the middle each time. Random access searches
+// do not branch: the start of the range moves forward or stays put
+// depending on one comparison, which compiles to a conditional move,
+// and the number of steps depends only on the size. For contiguous
+// sequences, both of the next possible midpoints are prefetched, so
+// the next load overlaps with the current comparison.
+//
+// Batched searches run search_batch searches in lock step. Since the
+// sequence of sizes does not depend on the keys, the loads of the
+// searches in a batch are independent, and their cache misses overlap.
+
+namespace impl
+{
+
+template<typename I>
+inline void
+prefetch(I)
+{ }
+
+template<ContiguousIterator I>
+inline void
+prefetch(I i)
+{
+  __builtin_prefetch(address(i));
+}
+
+
+// Returns the first position in [first, first + n) for which pred is
+// false. The sequence must be partitioned by pred.
+template<typename I, typename F>
+I
+partition_point_n(I first, difference_type_t<I> n, F& pred)
+{
+  while (n > 0) {
+    difference_type_t<I> half = n / 2;
+    I mid = stl::next(first, half);
+    if (stl::invoke(pred, *mid)) {
+      first = ++mid;
+      n -= half + 1;
+    } else {
+      n = half;
+    }
+  }
+  return first;
+}
+
+template<RandomAccessIterator I, typename F>
+I
+partition_point_n(I first, difference_type_t<I> n, F& pred)
+{
+  if (n == 0)
+    return first;
+  while (n > 1) {
+    difference_type_t<I> half = n / 2;
+    difference_type_t<I> next = (n - half) / 2;
+    impl::prefetch(first + next);
+    impl::prefetch(first + (half + next));
+    first = stl::invoke(pred, first[half]) ? first + half : first;
+    n -= half;
+  }
+  return first + stl::invoke(pred, *first);
+}
+
+
+template<typename I, typename T, typename C, typename P>
+inline I
+lower_bound(I first, difference_type_t<I> n, T const& value, C& comp, P& proj)
+{
+  auto pred = [&](auto&& x) -> bool {
+    return stl::invoke(comp, stl::invoke(proj, x), value);
+  };
+  return impl::partition_point_n(first, n, pred);
+}
+
+template<typename I, typename T, typename C, typename P>
+inline I
+upper_bound(I first, difference_type_t<I> n, T const& value, C& comp, P& proj)
+{
+  auto pred = [&](auto&& x) -> bool {
+    return !stl::invoke(comp, value, stl::invoke(proj, x));
+  };
+  return impl::partition_point_n(first, n, pred);
+}
+
+
+constexpr std::ptrdiff_t search_batch = 16;
+
+// Writes the lower bound of each of the m keys to out.
+template<typename I, typename K, typename O, typename C, typename P>
+O
+lower_bound_batch(I first, difference_type_t<I> n, K keys, std::ptrdiff_t m,
+                  O out, C& comp, P& proj)
+{
+  for (std::ptrdiff_t j = 0; j < m; ++j, ++out)
+    *out = impl::lower_bound(first, n, keys[j], comp, proj);
+  return out;
+}
+
+template<RandomAccessIterator I, typename K, typename O, typename C,
+         typename P>
+O
+lower_bound_batch(I first, difference_type_t<I> n, K keys, std::ptrdiff_t m,
+                  O out, C& comp, P& proj)
+{
+  constexpr std::ptrdiff_t g = search_batch;
+  I base[g];
+  for (std::ptrdiff_t j = 0; j < m; j += g) {
+    std::ptrdiff_t b = m - j < g ? m - j : g;
+    for (std::ptrdiff_t i = 0; i < b; ++i)
+      base[i] = first;
+    difference_type_t<I> len = n;
+    while (len > 1) {
+      difference_type_t<I> half = len / 2;
+      len -= half;
+      for (std::ptrdiff_t i = 0; i < b; ++i) {
+        I x = base[i];
+        bool right = stl::invoke(comp, stl::invoke(proj, x[half]), keys[j + i]);
+        base[i] = right ? x + half : x;
+        impl::prefetch(base[i] + len / 2);
+      }
+    }
+    for (std::ptrdiff_t i = 0; i < b; ++i, ++out)
+      *out = n == 0 ? first
+                    : base[i] + stl::invoke(comp, stl::invoke(proj, *base[i]), keys[j + i]);
+  }
+  return out;
+}
+
+} // namespace impl
+
+
+// Lower bound
+
+template<ForwardIterator I, Sentinel<I> S, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<I, P>>()
+inline I
+lower_bound(I first, S last, T const& value, C comp = C{}, P proj = P{})
+{
+  return impl::lower_bound(first, stl::distance(first, last), value, comp, proj);
+}
+
+template<ForwardRange R, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<iterator_t<R>, P>>()
+inline iterator_t<R>
+lower_bound(R&& range, T const& value, C comp = C{}, P proj = P{})
+{
+  return stl::lower_bound(begin(range), end(range), value, comp, proj);
+}
+
+
+// Upper bound
+
+template<ForwardIterator I, Sentinel<I> S, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<I, P>>()
+inline I
+upper_bound(I first, S last, T const& value, C comp = C{}, P proj = P{})
+{
+  return impl::upper_bound(first, stl::distance(first, last), value, comp, proj);
+}
+
+template<ForwardRange R, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<iterator_t<R>, P>>()
+inline iterator_t<R>
+upper_bound(R&& range, T const& value, C comp = C{}, P proj = P{})
+{
+  return stl::upper_bound(begin(range), end(range), value, comp, proj);
+}
+
+
+// Equal range
+
+template<ForwardIterator I, Sentinel<I> S, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<I, P>>()
+std::pair<I, I>
+equal_range(I first, S last, T const& value, C comp = C{}, P proj = P{})
+{
+  difference_type_t<I> n = stl::distance(first, last);
+  I lo = impl::lower_bound(first, n, value, comp, proj);
+  n -= stl::distance(first, lo);
+  return {lo, impl::upper_bound(lo, n, value, comp, proj)};
+}
+
+template<ForwardRange R, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<iterator_t<R>, P>>()
+inline std::pair<iterator_t<R>, iterator_t<R>>
+equal_range(R&& range, T const& value, C comp = C{}, P proj = P{})
+{
+  return stl::equal_range(begin(range), end(range), value, comp, proj);
+}
+
+
+// Binary search
+
+template<ForwardIterator I, Sentinel<I> S, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<I, P>>()
+bool
+binary_search(I first, S last, T const& value, C comp = C{}, P proj = P{})
+{
+  difference_type_t<I> n = stl::distance(first, last);
+  I i = impl::lower_bound(first, n, value, comp, proj);
+  return i != last && !stl::invoke(comp, value, stl::invoke(proj, *i));
+}
+
+template<ForwardRange R, typename T, typename C = less<>,
+         typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, T const*, projected<iterator_t<R>, P>>()
+inline bool
+binary_search(R&& range, T const& value, C comp = C{}, P proj = P{})
+{
+  return stl::binary_search(begin(range), end(range), value, comp, proj);
+}
+
+
+// Batch lower bound
+//
+// Writes the lower bound in the sorted range of each key to result.
+
+template<ForwardRange R, RandomAccessRange K, WeaklyIncrementable O,
+         typename C = less<>, typename P = identity_fn>
+  requires IndirectStrictWeakOrder<C, iterator_t<K>, projected<iterator_t<R>, P>>() &&
+           Writable<O, iterator_t<R>>()
+O
+batch_lower_bound(R&& range, K&& keys, O result, C comp = C{}, P proj = P{})
+{
+  auto first = begin(range);
+  auto n = stl::distance(first, end(range));
+  auto m = stl::distance(begin(keys), end(keys));
+  return impl::lower_bound_batch(first, n, begin(keys), m, result, comp, proj);
+}
+
 } // namespace stl
 
 #endif
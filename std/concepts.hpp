@@ -345,7 +345,7 @@ concept bool RegularFunction()
 template<typename P, typename... Args>
 concept bool Predicate()
 {
-  return RegularFunction<P, Args...>() && Boolean<result_of_t<P(Args...)>>();
+  return RegularFunction<P, Args...>() && Boolean<invoke_result_t<P, Args...>>();
 }
 
 
@@ -491,9 +491,27 @@ using difference_type_t = typename difference_type<T>::type;
 
 
 // Rvalue reference type
+//
+// iter_move(i) is the element at i as an rvalue: std::move(*i) when *i
+// is an lvalue, and *i otherwise. An iterator whose reference type is a
+// proxy overloads iter_move, to be found by argument dependent lookup,
+// so that moving out of an element moves what the proxy refers to.
+// Like swap, it is called unqualified, after using stl::iter_move.
+
+template<typename I>
+  requires requires (I const& i) { *i; }
+constexpr decltype(auto)
+iter_move(I const& i)
+{
+  if constexpr (is_lvalue_reference_v<decltype(*i)>)
+    return std::move(*i);
+  else
+    return *i;
+}
 
 template<typename T>
-using rvalue_reference_t = decltype(std::move(std::declval<reference_t<T>>()));
+  requires requires (T const& t) { iter_move(t); }
+using rvalue_reference_t = decltype(iter_move(std::declval<T const&>()));
 
 
 // Iterator type
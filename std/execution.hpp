@@ -0,0 +1,453 @@
+
+#ifndef STL_EXECUTION_HPP
+#define STL_EXECUTION_HPP
+
+#include "concepts.hpp"
+#include "functional.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace stl
+{
+
+// Thread pool
+//
+// A work-stealing pool. Each worker owns a deque of tasks: it pushes
+// and pops its own tasks at the back, and when it runs out, it steals
+// from the front of the other workers' deques. Tasks submitted from
+// threads outside the pool go to a shared queue.
+//
+// A thread that waits for tasks to complete (see task_group) runs
+// pending tasks while it waits, so nested parallelism cannot deadlock,
+// and blocks when there are none left to take.
+//
+// A task is a move-only function that fills a cache line. Its captures
+// are stored in the task when they fit, so submitting the tasks of the
+// parallel algorithms does not allocate.
+//
+// NOTE: Tasks must not throw. As with the standard parallel algorithms,
+// an exception escaping a task calls std::terminate.
+
+class thread_pool
+{
+public:
+  using task = unique_function<void(), 64 - sizeof(void*)>;
+
+  explicit thread_pool(std::size_t n = default_size());
+  ~thread_pool();
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool& operator=(thread_pool const&) = delete;
+
+  std::size_t size() const { return queues.size() - 1; }
+
+  void submit(task t);
+  bool run_pending();
+
+  template<typename F>
+  void run_until(F done);
+
+  void wake_all();
+
+  static std::size_t default_size();
+
+private:
+  struct queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  std::size_t self() const;
+  bool take(std::size_t self, task& t);
+  void work(std::size_t self);
+
+  static thread_pool*& current_pool();
+  static std::size_t& current_index();
+
+  std::vector<std::unique_ptr<queue>> queues;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::atomic<std::size_t> pending;
+  bool done;
+};
+
+// The number of threads in the default pool is given by the STL_THREADS
+// environment variable, or the number of hardware threads.
+inline std::size_t
+thread_pool::default_size()
+{
+  if (char const* s = std::getenv("STL_THREADS"))
+    if (int n = std::atoi(s))
+      return n > 0 ? n : 1;
+  std::size_t n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+// There is one queue per worker, plus the shared queue at the end.
+inline
+thread_pool::thread_pool(std::size_t n)
+  : pending(0), done(false)
+{
+  if (n == 0)
+    n = 1;
+  for (std::size_t i = 0; i <= n; ++i)
+    queues.emplace_back(new queue);
+  for (std::size_t i = 0; i < n; ++i)
+    threads.emplace_back([this, i]() { work(i); });
+}
+
+// Remaining tasks are run before the workers exit.
+inline
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  ready.notify_all();
+  for (std::thread& t : threads)
+    t.join();
+}
+
+inline thread_pool*&
+thread_pool::current_pool()
+{
+  static thread_local thread_pool* p = nullptr;
+  return p;
+}
+
+inline std::size_t&
+thread_pool::current_index()
+{
+  static thread_local std::size_t n = 0;
+  return n;
+}
+
+// Returns the queue of the calling thread: its own if it is one of our
+// workers, the shared queue otherwise.
+inline std::size_t
+thread_pool::self() const
+{
+  return current_pool() == this ? current_index() : size();
+}
+
+// The task is counted under its queue's lock, as take uncounts it, so
+// pending never goes below zero. Locking the pool's mutex before the
+// notification orders it after any worker's check of pending.
+inline void
+thread_pool::submit(task t)
+{
+  queue& q = *queues[self()];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.push_back(std::move(t));
+    ++pending;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+  }
+  ready.notify_one();
+}
+
+// Takes the newest task from our own queue, or else the oldest task from
+// the shared queue or another worker's queue.
+inline bool
+thread_pool::take(std::size_t self, task& t)
+{
+  std::size_t n = queues.size();
+  if (self != size()) {
+    queue& q = *queues[self];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      t = std::move(q.tasks.back());
+      q.tasks.pop_back();
+      --pending;
+      return true;
+    }
+  }
+  for (std::size_t i = 1; i <= n; ++i) {
+    queue& q = *queues[(self + i) % n];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.tasks.empty()) {
+      t = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      --pending;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void
+thread_pool::work(std::size_t self)
+{
+  current_pool() = this;
+  current_index() = self;
+  task t;
+  while (true) {
+    if (take(self, t)) {
+      t();
+      t = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [this]() { return done || pending != 0; });
+    if (done && pending == 0)
+      return;
+  }
+}
+
+// Runs one pending task on the calling thread, if there is one.
+inline bool
+thread_pool::run_pending()
+{
+  task t;
+  if (!take(self(), t))
+    return false;
+  t();
+  return true;
+}
+
+// Runs pending tasks on the calling thread until done() is true. When
+// there are none, it blocks until a task is submitted or wake_all is
+// called, rather than spinning while other threads run the tasks it
+// waits for.
+template<typename F>
+void
+thread_pool::run_until(F done)
+{
+  while (!done()) {
+    if (run_pending())
+      continue;
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [&]() { return pending != 0 || done(); });
+  }
+}
+
+// Wakes the threads blocked in run_until to check their condition.
+inline void
+thread_pool::wake_all()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+  }
+  ready.notify_all();
+}
+
+
+// Returns the pool used by parallel algorithms unless a policy names
+// another one.
+inline thread_pool&
+default_thread_pool()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+
+// Task group
+//
+// A set of tasks that can be waited on together.
+
+class task_group
+{
+public:
+  explicit task_group(thread_pool& p)
+    : pool(p), count(0)
+  { }
+
+  task_group(task_group const&) = delete;
+  task_group& operator=(task_group const&) = delete;
+
+  ~task_group() { wait(); }
+
+  template<typename F>
+  void run(F f);
+
+  void wait();
+
+private:
+  // The task that runs f and counts it as done. The last task of the
+  // group wakes its waiter; the group may be gone once count is zero, so
+  // the pool is read first.
+  template<typename F>
+  struct counted
+  {
+    task_group* group;
+    F f;
+
+    void operator()()
+    {
+      f();
+      thread_pool& pool = group->pool;
+      if (group->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        pool.wake_all();
+    }
+  };
+
+public:
+  // True if run(f) stores f in the task, so that it does not allocate.
+  template<typename F>
+  static constexpr bool stored_inline =
+    thread_pool::task::stored_inline<counted<F>>;
+
+private:
+  thread_pool& pool;
+  std::atomic<std::size_t> count;
+};
+
+template<typename F>
+inline void
+task_group::run(F f)
+{
+  count.fetch_add(1, std::memory_order_relaxed);
+  pool.submit(counted<F>{this, std::move(f)});
+}
+
+inline void
+task_group::wait()
+{
+  pool.run_until([this]() { return count.load(std::memory_order_acquire) == 0; });
+}
+
+
+// Execution policies
+//
+// The parallel policies run on the default thread pool, or on the pool
+// given by on(), e.g., par.on(pool).
+
+namespace execution
+{
+
+struct sequenced_policy
+{ };
+
+struct parallel_policy
+{
+  parallel_policy on(thread_pool& p) const { return parallel_policy{&p}; }
+
+  thread_pool* pool;
+};
+
+struct parallel_unsequenced_policy
+{
+  parallel_unsequenced_policy on(thread_pool& p) const
+  {
+    return parallel_unsequenced_policy{&p};
+  }
+
+  thread_pool* pool;
+};
+
+constexpr sequenced_policy seq { };
+constexpr parallel_policy par { nullptr };
+constexpr parallel_unsequenced_policy par_unseq { nullptr };
+
+} // namespace execution
+
+
+template<typename T>
+constexpr bool is_execution_policy_v = false;
+
+template<>
+constexpr bool is_execution_policy_v<execution::sequenced_policy> = true;
+
+template<>
+constexpr bool is_execution_policy_v<execution::parallel_policy> = true;
+
+template<>
+constexpr bool is_execution_policy_v<execution::parallel_unsequenced_policy> = true;
+
+
+template<typename E>
+concept bool ExecutionPolicy()
+{
+  return is_execution_policy_v<decay_t<E>>;
+}
+
+
+namespace impl
+{
+
+// Returns the pool that a policy runs on, or null if it is sequential.
+
+inline thread_pool*
+policy_pool(execution::sequenced_policy const&)
+{
+  return nullptr;
+}
+
+inline thread_pool*
+policy_pool(execution::parallel_policy const& p)
+{
+  return p.pool ? p.pool : &default_thread_pool();
+}
+
+inline thread_pool*
+policy_pool(execution::parallel_unsequenced_policy const& p)
+{
+  return p.pool ? p.pool : &default_thread_pool();
+}
+
+
+// Runs f in g. The tasks of the parallel algorithms capture a few
+// references and indices, which fit in a task, so submitting them does
+// not allocate. Larger state is captured through a reference to a local
+// closure or structure.
+template<typename F>
+inline void
+spawn(task_group& g, F f)
+{
+  static_assert(task_group::stored_inline<F>, "the task does not fit inline");
+  g.run(std::move(f));
+}
+
+
+// Sequences shorter than this are not worth splitting.
+constexpr std::ptrdiff_t parallel_grain = 1 << 14;
+
+template<typename F>
+void
+parallel_split(task_group& g, std::ptrdiff_t b, std::ptrdiff_t e,
+               std::ptrdiff_t grain, F const& f)
+{
+  while (e - b > grain) {
+    std::ptrdiff_t m = b + (e - b) / 2;
+    impl::spawn(g, [&g, m, e, grain, &f]() {
+      parallel_split(g, m, e, grain, f);
+    });
+    e = m;
+  }
+  f(b, e);
+}
+
+// Calls f(b, e) on the subranges of [0, n) in parallel. The range is
+// split in halves, so idle workers steal the largest remaining pieces.
+// There are about eight pieces per thread.
+template<typename F>
+void
+parallel_for(thread_pool& pool, std::ptrdiff_t n, F const& f)
+{
+  std::ptrdiff_t grain = n / (8 * static_cast<std::ptrdiff_t>(pool.size()));
+  if (grain < parallel_grain)
+    grain = parallel_grain;
+  task_group g(pool);
+  parallel_split(g, 0, n, grain, f);
+  g.wait();
+}
+
+} // namespace impl
+
+} // namespace stl
+
+#endif
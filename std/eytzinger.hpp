@@ -0,0 +1,212 @@
+
+#ifndef STL_EYTZINGER_HPP
+#define STL_EYTZINGER_HPP
+
+#include "algorithm.hpp"
+
+#include <vector>
+
+
+namespace stl
+{
+
+// Eytzinger index
+//
+// A copy of a sorted sequence, laid out in the breadth-first order of
+// the implicit binary search tree over it: the median first, then the
+// medians of each half, and so on. With 1-based positions, the children
+// of the node at k are at 2k and 2k + 1.
+//
+// The top levels of the tree, which every search visits, share a few
+// cache lines. The descendants of a node several levels down are
+// adjacent, so a search prefetches them prefetch_levels ahead (one cache
+// line), and the loads in the search loop hit the cache.
+//
+// The index is built from a forward range, which is traversed twice:
+// once to count the elements and once to place them.
+//
+// Searches return a pointer into the index, or end() if every element
+// is ordered before the key. Iterating over the index visits the
+// elements in tree order, not in sorted order.
+
+template<Semiregular T, typename C = less<>>
+class eytzinger_index
+{
+public:
+  using value_type = T;
+  using iterator = T const*;
+
+  eytzinger_index() = default;
+
+  template<ForwardRange R>
+    requires ConvertibleTo<reference_t<iterator_t<R>>, T>()
+  explicit eytzinger_index(R&& sorted, C c = C{});
+
+  std::size_t size() const { return nodes.size(); }
+  bool empty() const { return nodes.empty(); }
+
+  T const* begin() const { return nodes.data(); }
+  T const* end() const { return nodes.data() + nodes.size(); }
+
+  template<typename U>
+    requires StrictWeakOrder<C, T, U>()
+  T const* lower_bound(U const& value) const;
+
+  template<typename U>
+    requires StrictWeakOrder<C, T, U>()
+  T const* upper_bound(U const& value) const;
+
+  template<typename U>
+    requires StrictWeakOrder<C, T, U>()
+  bool contains(U const& value) const;
+
+  template<RandomAccessRange K, WeaklyIncrementable O>
+    requires StrictWeakOrder<C, T, value_type_t<iterator_t<K>>>() &&
+             Writable<O, T const*>()
+  O batch_lower_bound(K&& keys, O result) const;
+
+private:
+  // The number of levels spanned by one cache line of elements.
+  static constexpr int prefetch_levels =
+    sizeof(T) <= 4 ? 4 : sizeof(T) <= 8 ? 3 : sizeof(T) <= 16 ? 2 : 1;
+
+  template<typename I>
+  I build(I first, std::size_t k);
+
+  template<typename F>
+  std::size_t descend(F go_right) const;
+
+  void prefetch(std::size_t k) const;
+  T const* node(std::size_t k) const;
+
+  std::vector<T> nodes;
+  C comp;
+};
+
+// Fills the subtree at k from the sorted sequence by an in-order walk.
+template<Semiregular T, typename C>
+template<typename I>
+I
+eytzinger_index<T, C>::build(I first, std::size_t k)
+{
+  if (k <= nodes.size()) {
+    first = build(first, 2 * k);
+    nodes[k - 1] = *first;
+    ++first;
+    first = build(first, 2 * k + 1);
+  }
+  return first;
+}
+
+template<Semiregular T, typename C>
+template<ForwardRange R>
+  requires ConvertibleTo<reference_t<iterator_t<R>>, T>()
+eytzinger_index<T, C>::eytzinger_index(R&& sorted, C c)
+  : nodes(stl::distance(stl::begin(sorted), stl::end(sorted))), comp(c)
+{
+  build(stl::begin(sorted), 1);
+}
+
+// Prefetches the leftmost descendant of k prefetch_levels down.
+template<Semiregular T, typename C>
+inline void
+eytzinger_index<T, C>::prefetch(std::size_t k) const
+{
+  std::size_t d = k << prefetch_levels;
+  if (d <= nodes.size())
+    __builtin_prefetch(nodes.data() + (d - 1));
+}
+
+// Maps the position reached by a search to the result. The search went
+// right from every node after the last one it went left from; that node
+// is the result. If it never went left, there is no result.
+template<Semiregular T, typename C>
+inline T const*
+eytzinger_index<T, C>::node(std::size_t k) const
+{
+  k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+  return k ? nodes.data() + (k - 1) : end();
+}
+
+template<Semiregular T, typename C>
+template<typename F>
+inline std::size_t
+eytzinger_index<T, C>::descend(F go_right) const
+{
+  std::size_t n = nodes.size();
+  std::size_t k = 1;
+  while (k <= n) {
+    prefetch(k);
+    k = 2 * k + go_right(nodes[k - 1]);
+  }
+  return k;
+}
+
+template<Semiregular T, typename C>
+template<typename U>
+  requires StrictWeakOrder<C, T, U>()
+inline T const*
+eytzinger_index<T, C>::lower_bound(U const& value) const
+{
+  return node(descend([&](T const& x) -> bool { return comp(x, value); }));
+}
+
+template<Semiregular T, typename C>
+template<typename U>
+  requires StrictWeakOrder<C, T, U>()
+inline T const*
+eytzinger_index<T, C>::upper_bound(U const& value) const
+{
+  return node(descend([&](T const& x) -> bool { return !comp(value, x); }));
+}
+
+template<Semiregular T, typename C>
+template<typename U>
+  requires StrictWeakOrder<C, T, U>()
+inline bool
+eytzinger_index<T, C>::contains(U const& value) const
+{
+  T const* p = lower_bound(value);
+  return p != end() && !comp(value, *p);
+}
+
+// Keys are searched search_batch at a time, in lock step. Every search
+// takes the same number of steps through the complete levels of the
+// tree, and at most one more into the last level.
+template<Semiregular T, typename C>
+template<RandomAccessRange K, WeaklyIncrementable O>
+  requires StrictWeakOrder<C, T, value_type_t<iterator_t<K>>>() &&
+           Writable<O, T const*>()
+O
+eytzinger_index<T, C>::batch_lower_bound(K&& keys, O result) const
+{
+  constexpr std::ptrdiff_t g = impl::search_batch;
+  auto first = stl::begin(keys);
+  std::ptrdiff_t m = stl::distance(first, stl::end(keys));
+  std::size_t n = nodes.size();
+  int levels = 0;
+  while ((std::size_t(2) << levels) - 1 <= n)
+    ++levels;
+  std::size_t k[g];
+  for (std::ptrdiff_t j = 0; j < m; j += g) {
+    std::ptrdiff_t b = m - j < g ? m - j : g;
+    for (std::ptrdiff_t i = 0; i < b; ++i)
+      k[i] = 1;
+    for (int l = 0; l < levels; ++l)
+      for (std::ptrdiff_t i = 0; i < b; ++i) {
+        prefetch(k[i]);
+        k[i] = 2 * k[i] + comp(nodes[k[i] - 1], first[j + i]);
+      }
+    for (std::ptrdiff_t i = 0; i < b; ++i) {
+      if (k[i] <= n)
+        k[i] = 2 * k[i] + comp(nodes[k[i] - 1], first[j + i]);
+      *result = node(k[i]);
+      ++result;
+    }
+  }
+  return result;
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,2 @@
+
+#include "flat_hash.hpp"
@@ -0,0 +1,832 @@
+
+#ifndef STL_FLAT_HASH_HPP
+#define STL_FLAT_HASH_HPP
+
+#include "functional.hpp"
+#include "hash.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+
+namespace stl
+{
+
+// Flat hash tables
+//
+// flat_hash_map and flat_hash_set are open-addressing hash tables in the
+// style of the Swiss table. The elements are stored in one array of
+// slots, with no nodes, and a parallel array holds a control byte per
+// slot: whether it is empty, deleted, or full, and, if it is full, 7 bits
+// of the hash of its key.
+//
+// A lookup hashes the key once. The high bits choose where to start, and
+// the control bytes are probed a group of 16 at a time: one SSE2 compare
+// finds the slots in the group whose 7 bits match, and only those keys
+// are compared. Most lookups touch one group of control bytes and one
+// slot. The probe ends at a group with an empty slot.
+//
+// The tables are at most 7/8 full. reserve(n) makes room for n elements,
+// so that inserting them does not rehash. Erasing an element leaves a
+// tombstone, unless no probe can have passed it; tombstones are cleared
+// when the table is rehashed.
+//
+// The hash and equality functions default to hash<> and equal_to<>,
+// which are transparent: find, contains, count, and erase accept any
+// type that compares equal to the key type, such as a string_view or a
+// string literal for a string key, without constructing a key. The
+// hashes of equal values must be equal, and hash<> only hashes values of
+// the same type alike, so a lookup value that converts implicitly to the
+// key type, such as an int for a size_t key, is converted first.
+//
+// Unlike the standard unordered containers, inserting an element may move
+// the others, so it invalidates all iterators, references and pointers
+// into the table.
+
+namespace impl
+{
+
+// Control bytes. Full slots have the 7 bits of their hash, which are
+// non-negative.
+using ctrl_t = signed char;
+
+constexpr ctrl_t ctrl_empty = -128;
+constexpr ctrl_t ctrl_deleted = -2;
+
+constexpr std::size_t group_width = 16;
+
+// A group of 16 control bytes, which need not be aligned. Each query
+// returns the positions in the group that match, as a bit mask.
+#if defined(__SSE2__)
+struct ctrl_group
+{
+  explicit ctrl_group(ctrl_t const* p)
+    : ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)))
+  { }
+
+  unsigned match(ctrl_t h) const
+  {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl));
+  }
+
+  unsigned empty() const { return match(ctrl_empty); }
+
+  // Empty and deleted slots have the high bit set.
+  unsigned free() const { return _mm_movemask_epi8(ctrl); }
+
+  unsigned full() const { return free() ^ 0xffff; }
+
+  __m128i ctrl;
+};
+#else
+struct ctrl_group
+{
+  explicit ctrl_group(ctrl_t const* p)
+  {
+    std::memcpy(ctrl, p, group_width);
+  }
+
+  unsigned match(ctrl_t h) const
+  {
+    unsigned m = 0;
+    for (std::size_t i = 0; i < group_width; ++i)
+      m |= unsigned(ctrl[i] == h) << i;
+    return m;
+  }
+
+  unsigned empty() const { return match(ctrl_empty); }
+
+  unsigned free() const
+  {
+    unsigned m = 0;
+    for (std::size_t i = 0; i < group_width; ++i)
+      m |= unsigned(ctrl[i] < 0) << i;
+    return m;
+  }
+
+  unsigned full() const { return free() ^ 0xffff; }
+
+  ctrl_t ctrl[group_width];
+};
+#endif
+
+// The control bytes of a table with no slots. Probing it finds an empty
+// slot at once, so lookups in an empty table do not need a branch.
+alignas(group_width) inline ctrl_t const empty_ctrl[group_width] = {
+  ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+  ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+  ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+  ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+};
+
+// The number of elements a table of capacity n may hold.
+constexpr std::size_t
+max_load(std::size_t n)
+{
+  return n - n / 8;
+}
+
+// The least capacity, a power of two, that holds n elements.
+inline std::size_t
+capacity_for(std::size_t n)
+{
+  std::size_t c = group_width;
+  while (max_load(c) < n)
+    c *= 2;
+  return c;
+}
+
+template<typename T>
+constexpr bool is_transparent_v = requires { typename T::is_transparent; };
+
+// True if U is a pointer to, or an array of, the characters C.
+template<typename U, typename C>
+constexpr bool is_c_string_v =
+  std::is_same<std::remove_cv_t<std::remove_pointer_t<std::decay_t<U>>>, C>::value &&
+  (std::is_pointer<U>::value || std::is_array<U>::value);
+
+// True if U is a C string of the characters of the string type K.
+template<typename K, typename U>
+constexpr bool is_c_string_of_v = false;
+
+template<typename C, typename T, typename A, typename U>
+constexpr bool is_c_string_of_v<std::basic_string<C, T, A>, U> = is_c_string_v<U, C>;
+
+template<typename C, typename T, typename U>
+constexpr bool is_c_string_of_v<std::basic_string_view<C, T>, U> = is_c_string_v<U, C>;
+
+// Returns the value that a lookup of k in a table of keys K hashes and
+// compares. Hashes are only equal for values of the same type, so k is
+// converted to the key type when it can be implicitly: a string literal,
+// pointer or array of characters looks up a string key as the string it
+// holds, which ends at its first null character or the end of the
+// array, and, e.g., an int looks up a size_t key as a size_t. Other
+// types, such as a string_view for a string key, are used as they are.
+template<typename K, typename U>
+inline decltype(auto)
+lookup_key(U const& k)
+{
+  if constexpr (std::is_same<U, K>::value) {
+    return k;
+  } else if constexpr (is_c_string_of_v<K, U>) {
+    using view = std::basic_string_view<typename K::value_type, typename K::traits_type>;
+    if constexpr (std::is_pointer<U>::value) {
+      return view(k);
+    } else {
+      std::size_t n = 0;
+      while (n < std::extent<U>::value && k[n] != typename K::value_type())
+        ++n;
+      return view(k, n);
+    }
+  } else if constexpr (std::is_convertible<U const&, K>::value) {
+    return K(k);
+  } else {
+    return k;
+  }
+}
+
+
+// The table underlying the maps and sets. The policy P gives the key and
+// value types, the key of a value, and how to relocate a value.
+template<typename P, typename H, typename E>
+class hash_table
+{
+public:
+  using key_type = typename P::key_type;
+  using value_type = typename P::value_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = H;
+  using key_equal = E;
+
+  template<bool Const>
+  class basic_iterator;
+
+  using const_iterator = basic_iterator<true>;
+  using iterator = basic_iterator<P::constant>;
+
+  hash_table() = default;
+
+  explicit hash_table(size_type n, H h = H(), E e = E())
+    : hash_fn(std::move(h)), eq_fn(std::move(e))
+  {
+    reserve(n);
+  }
+
+  hash_table(hash_table const& x)
+    : hash_fn(x.hash_fn), eq_fn(x.eq_fn)
+  {
+    reserve(x.elems);
+    for (value_type const& v : x)
+      insert_unique(v);
+  }
+
+  hash_table(hash_table&& x) noexcept
+    : ctrl(std::exchange(x.ctrl, const_cast<ctrl_t*>(empty_ctrl))),
+      slots(std::exchange(x.slots, nullptr)),
+      cap(std::exchange(x.cap, 0)),
+      elems(std::exchange(x.elems, 0)),
+      growth(std::exchange(x.growth, 0)),
+      hash_fn(x.hash_fn),
+      eq_fn(x.eq_fn)
+  { }
+
+  hash_table& operator=(hash_table const& x)
+  {
+    hash_table tmp(x);
+    swap(tmp);
+    return *this;
+  }
+
+  hash_table& operator=(hash_table&& x) noexcept
+  {
+    hash_table tmp(std::move(x));
+    swap(tmp);
+    return *this;
+  }
+
+  ~hash_table() { release(); }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this); }
+
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return elems == 0; }
+  size_type size() const { return elems; }
+  size_type capacity() const { return cap; }
+
+  float load_factor() const { return cap ? float(elems) / cap : 0; }
+
+  hasher hash_function() const { return hash_fn; }
+  key_equal key_eq() const { return eq_fn; }
+
+  void reserve(size_type n);
+  void rehash(size_type n);
+  void clear();
+
+  void swap(hash_table& x) noexcept
+  {
+    using std::swap;
+    swap(ctrl, x.ctrl);
+    swap(slots, x.slots);
+    swap(cap, x.cap);
+    swap(elems, x.elems);
+    swap(growth, x.growth);
+    swap(hash_fn, x.hash_fn);
+    swap(eq_fn, x.eq_fn);
+  }
+
+  friend void swap(hash_table& a, hash_table& b) noexcept { a.swap(b); }
+
+  iterator find(key_type const& k) { return at_index(find_index(k)); }
+  const_iterator find(key_type const& k) const { return at_index(find_index(k)); }
+
+  template<typename U>
+    requires is_transparent_v<H> && is_transparent_v<E>
+  iterator find(U const& k) { return at_index(find_index(k)); }
+
+  template<typename U>
+    requires is_transparent_v<H> && is_transparent_v<E>
+  const_iterator find(U const& k) const { return at_index(find_index(k)); }
+
+  bool contains(key_type const& k) const { return find_index(k) != npos; }
+
+  template<typename U>
+    requires is_transparent_v<H> && is_transparent_v<E>
+  bool contains(U const& k) const { return find_index(k) != npos; }
+
+  size_type erase(key_type const& k) { return erase_key(k); }
+
+  template<typename U>
+    requires is_transparent_v<H> && is_transparent_v<E>
+          && !is_convertible_v<U const&, const_iterator>
+  size_type erase(U const& k) { return erase_key(k); }
+
+  iterator erase(const_iterator i)
+  {
+    size_type n = i.pos;
+    erase_index(n);
+    return iterator(this, n + 1);
+  }
+
+protected:
+  static constexpr size_type npos = size_type(-1);
+
+  // Returns the slot of the key k, whose hash is h, or npos.
+  template<typename U>
+  size_type find_index(U const& k, size_type h) const;
+
+  template<typename U>
+  size_type find_index(U const& k) const
+  {
+    auto&& x = impl::lookup_key<key_type>(k);
+    return find_index(x, hash_fn(x));
+  }
+
+  // Returns the first empty or deleted slot on the probe sequence of h.
+  size_type find_free(size_type h) const;
+
+  // Inserts the value constructed from args, whose key is k, if there
+  // is no element with that key.
+  template<typename U, typename... Args>
+  std::pair<iterator, bool> emplace_key(U const& k, Args&&... args);
+
+  template<typename V>
+  void insert_unique(V&& v);
+
+  template<typename U>
+  size_type erase_key(U const& k);
+
+  void erase_index(size_type i);
+
+  iterator at_index(size_type i) const
+  {
+    return i == npos ? iterator(this) : iterator(this, i, 0);
+  }
+
+  value_type& slot(size_type i) const { return slots[i]; }
+
+private:
+  static unsigned h2(size_type h) { return h & 0x7f; }
+
+  // Zero for the empty table, which probes empty_ctrl.
+  size_type mask() const { return cap - (cap != 0); }
+
+  // Sets the control byte of slot i, and its copy past the end.
+  void set_ctrl(size_type i, ctrl_t c)
+  {
+    ctrl[i] = c;
+    if (i < group_width)
+      ctrl[cap + i] = c;
+  }
+
+  void resize(size_type n);
+  void release();
+
+  // The control bytes of the first group are copied past the end, so
+  // that a group can be read at any slot.
+  ctrl_t* ctrl = const_cast<ctrl_t*>(empty_ctrl);
+  value_type* slots = nullptr;
+  size_type cap = 0;
+  size_type elems = 0;
+  size_type growth = 0;
+  H hash_fn;
+  E eq_fn;
+};
+
+
+// Iterators visit the full slots in order. Advancing skips a group of
+// empty slots at a time.
+template<typename P, typename H, typename E>
+template<bool Const>
+class hash_table<P, H, E>::basic_iterator
+{
+  friend class hash_table;
+
+public:
+  using value_type = typename P::value_type;
+  using reference = conditional_t<Const, value_type const&, value_type&>;
+  using pointer = conditional_t<Const, value_type const*, value_type*>;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  basic_iterator() = default;
+
+  template<bool C>
+    requires Const && !C
+  basic_iterator(basic_iterator<C> const& i)
+    : table(i.table), pos(i.pos)
+  { }
+
+  reference operator*() const { return table->slot(pos); }
+  pointer operator->() const { return std::addressof(table->slot(pos)); }
+
+  basic_iterator& operator++()
+  {
+    ++pos;
+    skip();
+    return *this;
+  }
+
+  basic_iterator operator++(int)
+  {
+    basic_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  friend bool operator==(basic_iterator const& a, basic_iterator const& b)
+  {
+    return a.pos == b.pos;
+  }
+
+  friend bool operator!=(basic_iterator const& a, basic_iterator const& b)
+  {
+    return a.pos != b.pos;
+  }
+
+private:
+  template<bool>
+  friend class basic_iterator;
+
+  // The end.
+  explicit basic_iterator(hash_table const* t)
+    : table(t), pos(t->cap)
+  { }
+
+  // The first full slot at or after i.
+  basic_iterator(hash_table const* t, size_type i)
+    : table(t), pos(i)
+  {
+    skip();
+  }
+
+  // The full slot i.
+  basic_iterator(hash_table const* t, size_type i, int)
+    : table(t), pos(i)
+  { }
+
+  void skip()
+  {
+    size_type n = table->cap;
+    while (pos < n) {
+      unsigned m = ctrl_group(table->ctrl + pos).full();
+      if (m) {
+        pos += __builtin_ctz(m);
+        break;
+      }
+      pos += group_width;
+    }
+    if (pos > n)
+      pos = n;
+  }
+
+  hash_table const* table = nullptr;
+  size_type pos = 0;
+};
+
+
+template<typename P, typename H, typename E>
+template<typename U>
+auto
+hash_table<P, H, E>::find_index(U const& k, size_type h) const -> size_type
+{
+  size_type m = mask();
+  size_type pos = (h >> 7) & m;
+  size_type step = 0;
+  while (true) {
+    ctrl_group g(ctrl + pos);
+    for (unsigned b = g.match(h2(h)); b; b &= b - 1) {
+      size_type i = (pos + __builtin_ctz(b)) & m;
+      if (eq_fn(P::key(slots[i]), k))
+        return i;
+    }
+    if (g.empty())
+      return npos;
+    step += group_width;
+    pos = (pos + step) & m;
+  }
+}
+
+template<typename P, typename H, typename E>
+auto
+hash_table<P, H, E>::find_free(size_type h) const -> size_type
+{
+  size_type m = mask();
+  size_type pos = (h >> 7) & m;
+  size_type step = 0;
+  while (true) {
+    if (unsigned b = ctrl_group(ctrl + pos).free())
+      return (pos + __builtin_ctz(b)) & m;
+    step += group_width;
+    pos = (pos + step) & m;
+  }
+}
+
+// When the table is full, it is rehashed at the same capacity if
+// tombstones take most of the room, and at twice the capacity otherwise.
+template<typename P, typename H, typename E>
+template<typename U, typename... Args>
+auto
+hash_table<P, H, E>::emplace_key(U const& k, Args&&... args)
+  -> std::pair<iterator, bool>
+{
+  size_type h = hash_fn(k);
+  size_type i = find_index(k, h);
+  if (i != npos)
+    return {iterator(this, i, 0), false};
+  i = find_free(h);
+  if (growth == 0 && ctrl[i] != ctrl_deleted) {
+    resize(cap == 0 ? group_width : elems < max_load(cap) / 2 ? cap : cap * 2);
+    i = find_free(h);
+  }
+  ::new (static_cast<void*>(slots + i)) value_type(std::forward<Args>(args)...);
+  growth -= ctrl[i] == ctrl_empty;
+  set_ctrl(i, h2(h));
+  ++elems;
+  return {iterator(this, i, 0), true};
+}
+
+template<typename P, typename H, typename E>
+template<typename V>
+void
+hash_table<P, H, E>::insert_unique(V&& v)
+{
+  emplace_key(P::key(v), std::forward<V>(v));
+}
+
+template<typename P, typename H, typename E>
+template<typename U>
+auto
+hash_table<P, H, E>::erase_key(U const& k) -> size_type
+{
+  size_type i = find_index(k);
+  if (i == npos)
+    return 0;
+  erase_index(i);
+  return 1;
+}
+
+// A slot can be made empty again if every group that contains it has an
+// empty slot, so that no probe can have passed over it. Otherwise it is
+// a tombstone.
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::erase_index(size_type i)
+{
+  slots[i].~value_type();
+  --elems;
+  unsigned before = ctrl_group(ctrl + ((i - group_width) & mask())).empty();
+  unsigned after = ctrl_group(ctrl + i).empty();
+  bool never_full = before && after &&
+    __builtin_ctz(after) + (__builtin_clz(before) - 16) < int(group_width);
+  set_ctrl(i, never_full ? ctrl_empty : ctrl_deleted);
+  growth += never_full;
+}
+
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::reserve(size_type n)
+{
+  if (n > elems + growth)
+    resize(capacity_for(n) > cap ? capacity_for(n) : cap);
+}
+
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::rehash(size_type n)
+{
+  n = capacity_for(n > elems ? n : elems);
+  if (n != cap || elems + growth < max_load(cap))
+    resize(n);
+}
+
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::clear()
+{
+  for (size_type i = 0; i < cap; ++i)
+    if (ctrl[i] >= 0)
+      slots[i].~value_type();
+  if (cap)
+    std::memset(ctrl, ctrl_empty, cap + group_width);
+  elems = 0;
+  growth = max_load(cap);
+}
+
+// Moves the elements to a new table of capacity n. Values that are
+// trivially relocatable are copied as bytes.
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::resize(size_type n)
+{
+  hash_table t;
+  t.ctrl = new ctrl_t[n + group_width];
+  std::memset(t.ctrl, ctrl_empty, n + group_width);
+  t.slots = std::allocator<value_type>().allocate(n);
+  t.cap = n;
+  for (size_type i = 0; i < cap; ++i) {
+    if (ctrl[i] < 0)
+      continue;
+    size_type h = hash_fn(P::key(slots[i]));
+    size_type j = t.find_free(h);
+    if constexpr (is_trivially_relocatable_v<value_type>)
+      std::memcpy(static_cast<void*>(t.slots + j), slots + i, sizeof(value_type));
+    else
+      P::relocate(t.slots + j, slots + i);
+    t.set_ctrl(j, h2(h));
+  }
+  t.elems = elems;
+  t.growth = max_load(n) - elems;
+  std::swap(ctrl, t.ctrl);
+  std::swap(slots, t.slots);
+  std::swap(cap, t.cap);
+  std::swap(elems, t.elems);
+  std::swap(growth, t.growth);
+
+  // The old slots have been moved from.
+  t.elems = 0;
+  std::memset(t.ctrl, ctrl_empty, t.cap);
+}
+
+template<typename P, typename H, typename E>
+void
+hash_table<P, H, E>::release()
+{
+  if (cap == 0)
+    return;
+  for (size_type i = 0; i < cap; ++i)
+    if (ctrl[i] >= 0)
+      slots[i].~value_type();
+  std::allocator<value_type>().deallocate(slots, cap);
+  delete[] ctrl;
+}
+
+
+template<typename K, typename V>
+struct map_policy
+{
+  using key_type = K;
+  using value_type = std::pair<K const, V>;
+
+  static constexpr bool constant = false;
+
+  static K const& key(value_type const& v) { return v.first; }
+
+  // The source is destroyed at once, so its key may be moved from.
+  static void relocate(value_type* dst, value_type* src)
+  {
+    ::new (static_cast<void*>(dst))
+      value_type(std::move(const_cast<K&>(src->first)), std::move(src->second));
+    src->~value_type();
+  }
+};
+
+template<typename T>
+struct set_policy
+{
+  using key_type = T;
+  using value_type = T;
+
+  static constexpr bool constant = true;
+
+  static T const& key(T const& v) { return v; }
+
+  static void relocate(T* dst, T* src)
+  {
+    ::new (static_cast<void*>(dst)) T(std::move(*src));
+    src->~T();
+  }
+};
+
+} // namespace impl
+
+
+// Flat hash map
+
+template<typename K, typename V, typename H = hash<>, typename E = equal_to<>>
+class flat_hash_map : public impl::hash_table<impl::map_policy<K, V>, H, E>
+{
+  using base = impl::hash_table<impl::map_policy<K, V>, H, E>;
+
+public:
+  using mapped_type = V;
+  using typename base::key_type;
+  using typename base::value_type;
+  using typename base::size_type;
+  using typename base::iterator;
+  using typename base::const_iterator;
+
+  using base::base;
+
+  flat_hash_map() = default;
+
+  flat_hash_map(std::initializer_list<value_type> list)
+    : base(list.size())
+  {
+    for (value_type const& v : list)
+      insert(v);
+  }
+
+  std::pair<iterator, bool> insert(value_type const& v)
+  {
+    return this->emplace_key(v.first, v);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& v)
+  {
+    return this->emplace_key(v.first, std::move(v));
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type const& k, Args&&... args)
+  {
+    return this->emplace_key(k, std::piecewise_construct,
+                             std::forward_as_tuple(k),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args)
+  {
+    return this->emplace_key(k, std::piecewise_construct,
+                             std::forward_as_tuple(std::move(k)),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  V& operator[](key_type const& k) { return try_emplace(k).first->second; }
+  V& operator[](key_type&& k) { return try_emplace(std::move(k)).first->second; }
+
+  V& at(key_type const& k)
+  {
+    iterator i = this->find(k);
+    if (i == this->end())
+      throw std::out_of_range("flat_hash_map::at");
+    return i->second;
+  }
+
+  V const& at(key_type const& k) const
+  {
+    const_iterator i = this->find(k);
+    if (i == this->end())
+      throw std::out_of_range("flat_hash_map::at");
+    return i->second;
+  }
+
+  size_type count(key_type const& k) const { return this->contains(k); }
+
+  template<typename U>
+    requires impl::is_transparent_v<H> && impl::is_transparent_v<E>
+  size_type count(U const& k) const { return this->contains(k); }
+};
+
+
+// Flat hash set
+
+template<typename T, typename H = hash<>, typename E = equal_to<>>
+class flat_hash_set : public impl::hash_table<impl::set_policy<T>, H, E>
+{
+  using base = impl::hash_table<impl::set_policy<T>, H, E>;
+
+public:
+  using typename base::key_type;
+  using typename base::value_type;
+  using typename base::size_type;
+  using typename base::iterator;
+  using typename base::const_iterator;
+
+  using base::base;
+
+  flat_hash_set() = default;
+
+  flat_hash_set(std::initializer_list<T> list)
+    : base(list.size())
+  {
+    for (T const& x : list)
+      insert(x);
+  }
+
+  std::pair<iterator, bool> insert(T const& x) { return this->emplace_key(x, x); }
+  std::pair<iterator, bool> insert(T&& x) { return this->emplace_key(x, std::move(x)); }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args)
+  {
+    return insert(T(std::forward<Args>(args)...));
+  }
+
+  size_type count(T const& k) const { return this->contains(k); }
+
+  template<typename U>
+    requires impl::is_transparent_v<H> && impl::is_transparent_v<E>
+  size_type count(U const& k) const { return this->contains(k); }
+};
+
+} // namespace stl
+
+#endif
@@ -5,32 +5,272 @@
 #include "concepts.hpp"
 
 #include <cstddef>
-// For std::size_t.
+// For std::size_t and std::max_align_t.
 
-#include <functional>
-// For std::mem_fn.
-//
-// NOTE: This header dramatically slows build times.
+#include <cstring>
+// For std::memcpy.
 
-namespace stl
-{
+#include <memory>
+// For std::addressof.
 
-// Invoke
+#include <new>
+// For std::launder.
 
-// FIXME: Actually implement invoke.
-template<typename F, typename... Args>
-result_of_t<F(Args...)> invoke(F&& f, Args&&... args)
+namespace stl
 {
-  return std::forward<F>(f)(std::forward<Args>(args)...);
-}
-
 
 // Identity function
 
 struct identity_fn
 {
   template<typename T>
-  constexpr T& operator()(T&& t) const noexcept { return std::forward<T>(t); }
+  constexpr T&& operator()(T&& t) const noexcept { return std::forward<T>(t); }
+};
+
+
+// Function reference
+//
+// A function_ref<R(Args...)> refers to a callable that can be invoked
+// with Args and returns something convertible to R. It is two pointers
+// wide: the address of the callable and a function that invokes it. It
+// never allocates, and a call is one indirect call, so it is cheap to
+// pass callbacks to functions that are not templates:
+//
+//    void for_each_line(char const* path, function_ref<void(char const*)> f);
+//
+// It does not own the callable, which must outlive it. Functions are
+// referred to by pointer, so they may be given by name.
+
+template<typename S>
+class function_ref;
+
+template<typename R, typename... Args>
+class function_ref<R(Args...)>
+{
+  union storage
+  {
+    void const* obj;
+    void (*fn)();
+  };
+
+  using thunk = R (*)(storage, Args...);
+
+  template<typename F>
+  static R call_object(storage s, Args... args)
+  {
+    F& f = *static_cast<F*>(const_cast<void*>(s.obj));
+    return static_cast<R>(stl::invoke(f, std::forward<Args>(args)...));
+  }
+
+  template<typename F>
+  static R call_function(storage s, Args... args)
+  {
+    F* f = reinterpret_cast<F*>(s.fn);
+    return static_cast<R>(f(std::forward<Args>(args)...));
+  }
+
+public:
+  template<typename F>
+    requires std::is_function<F>::value
+          && Callable<F*, Args...>()
+          && (std::is_void<R>::value || is_convertible_v<invoke_result_t<F*, Args...>, R>)
+  function_ref(F* f) noexcept
+    : call(&call_function<F>)
+  {
+    fun.fn = reinterpret_cast<void (*)()>(f);
+  }
+
+  template<typename F>
+    requires !std::is_same<decay_t<F>, function_ref>::value
+          && !std::is_function<remove_reference_t<F>>::value
+          && Callable<remove_reference_t<F>&, Args...>()
+          && (std::is_void<R>::value ||
+              is_convertible_v<invoke_result_t<remove_reference_t<F>&, Args...>, R>)
+  function_ref(F&& f) noexcept
+    : call(&call_object<remove_reference_t<F>>)
+  {
+    fun.obj = std::addressof(f);
+  }
+
+  template<typename F>
+    requires std::is_function<F>::value
+  function_ref(F& f) noexcept
+    : function_ref(&f)
+  { }
+
+  R operator()(Args... args) const
+  {
+    return call(fun, std::forward<Args>(args)...);
+  }
+
+private:
+  storage fun;
+  thunk call;
+};
+
+
+// Unique function
+//
+// A unique_function<R(Args...), N> owns a callable that can be invoked
+// with Args and returns something convertible to R. Unlike std::function,
+// it is move-only, so the callable may be too (e.g., a lambda that
+// captures a unique_ptr).
+//
+// A callable of at most N bytes whose move constructor does not throw is
+// stored in the object; larger ones are allocated. N is four pointers by
+// default, which holds a lambda capturing a few references.
+//
+// Moving a unique_function copies its bytes when the callable is
+// allocated or trivially relocatable (see is_trivially_relocatable_v),
+// and otherwise calls its move constructor. A moved-from unique_function
+// is empty. Calling an empty unique_function is undefined.
+
+template<typename S, std::size_t N = 4 * sizeof(void*)>
+class unique_function;
+
+template<typename R, typename... Args, std::size_t N>
+class unique_function<R(Args...), N>
+{
+  static_assert(N >= sizeof(void*), "the buffer must hold a pointer");
+
+  struct operations
+  {
+    R (*call)(void*, Args&&...);
+
+    // Null when the buffer can be copied.
+    void (*relocate)(void*, void*) noexcept;
+
+    void (*destroy)(void*) noexcept;
+  };
+
+public:
+  // True if a callable of type F is stored in the object.
+  template<typename F>
+  static constexpr bool stored_inline =
+    sizeof(F) <= N && alignof(F) <= alignof(std::max_align_t) &&
+    std::is_nothrow_move_constructible<F>::value;
+
+private:
+  template<typename F, bool Inline = stored_inline<F>>
+  struct model;
+
+  template<typename F>
+  struct model<F, true>
+  {
+    static F& get(void* p) { return *std::launder(static_cast<F*>(p)); }
+
+    static R call(void* p, Args&&... args)
+    {
+      return static_cast<R>(stl::invoke(get(p), std::forward<Args>(args)...));
+    }
+
+    static void relocate(void* dst, void* src) noexcept
+    {
+      ::new (dst) F(std::move(get(src)));
+      get(src).~F();
+    }
+
+    static void destroy(void* p) noexcept { get(p).~F(); }
+
+    static constexpr operations ops {
+      &call,
+      is_trivially_relocatable_v<F> ? nullptr : &relocate,
+      &destroy
+    };
+  };
+
+  template<typename F>
+  struct model<F, false>
+  {
+    static F& get(void* p) { return **static_cast<F**>(p); }
+
+    static R call(void* p, Args&&... args)
+    {
+      return static_cast<R>(stl::invoke(get(p), std::forward<Args>(args)...));
+    }
+
+    static void destroy(void* p) noexcept { delete &get(p); }
+
+    static constexpr operations ops {&call, nullptr, &destroy};
+  };
+
+public:
+  unique_function() noexcept = default;
+
+  unique_function(std::nullptr_t) noexcept { }
+
+  template<typename F>
+    requires !std::is_same<decay_t<F>, unique_function>::value
+          && MoveConstructible<decay_t<F>>()
+          && Callable<decay_t<F>&, Args...>()
+          && (std::is_void<R>::value ||
+              is_convertible_v<invoke_result_t<decay_t<F>&, Args...>, R>)
+  unique_function(F&& f)
+  {
+    using G = decay_t<F>;
+    // A null pointer gives an empty function. (A function reference is
+    // never null.)
+    if constexpr (!std::is_function<remove_reference_t<F>>::value &&
+                  (std::is_pointer<G>::value || is_member_pointer_v<G>))
+      if (!f)
+        return;
+    if constexpr (stored_inline<G>)
+      ::new (static_cast<void*>(buf)) G(std::forward<F>(f));
+    else
+      ::new (static_cast<void*>(buf)) G*(new G(std::forward<F>(f)));
+    ops = &model<G>::ops;
+  }
+
+  unique_function(unique_function&& x) noexcept
+  {
+    take(x);
+  }
+
+  unique_function& operator=(unique_function&& x) noexcept
+  {
+    if (this != &x) {
+      reset();
+      take(x);
+    }
+    return *this;
+  }
+
+  unique_function& operator=(std::nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  ~unique_function() { reset(); }
+
+  explicit operator bool() const noexcept { return ops != nullptr; }
+
+  R operator()(Args... args)
+  {
+    return ops->call(buf, std::forward<Args>(args)...);
+  }
+
+private:
+  // Moves the callable of x into this empty function.
+  void take(unique_function& x) noexcept
+  {
+    if (!x.ops)
+      return;
+    if (x.ops->relocate)
+      x.ops->relocate(buf, x.buf);
+    else
+      std::memcpy(buf, x.buf, N);
+    ops = std::exchange(x.ops, nullptr);
+  }
+
+  void reset() noexcept
+  {
+    if (ops)
+      std::exchange(ops, nullptr)->destroy(buf);
+  }
+
+  alignas(std::max_align_t) unsigned char buf[N];
+  operations const* ops = nullptr;
 };
 
 
@@ -50,6 +290,8 @@ struct equal_to<T>
 template<>
 struct equal_to<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires EqualityComparable<T, U>()
   bool operator()(T const& a, U const& b) const { return a == b; }
@@ -68,6 +310,8 @@ struct not_equal_to<T>
 template<>
 struct not_equal_to<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires EqualityComparable<T, U>()
   bool operator()(T const& a, U const& b) const { return a != b; }
@@ -92,6 +336,8 @@ struct less<T*>
 template<>
 struct less<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires TotallyOrdered<T, U>()
   bool operator()(T const& a, U const& b) const { return a < b; }
@@ -119,6 +365,8 @@ struct greater<T*>
 template<>
 struct greater<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires TotallyOrdered<T, U>()
   bool operator()(T const& a, U const& b) const { return a > b; }
@@ -146,6 +394,8 @@ struct less_equal<T*>
 template<>
 struct less_equal<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires TotallyOrdered<T, U>()
   bool operator()(T const& a, U const& b) const { return a <= b; }
@@ -173,6 +423,8 @@ struct greater_equal<T*>
 template<>
 struct greater_equal<void>
 {
+  using is_transparent = void;
+
   template<typename T, typename U>
     requires TotallyOrdered<T, U>()
   bool operator()(T const& a, U const& b) const { return a >= b; }
@@ -182,6 +434,44 @@ struct greater_equal<void>
 };
 
 
+// Arithmetic function objects
+
+template<typename T = void>
+struct plus
+{
+  T operator()(T const& a, T const& b) const { return a + b; }
+};
+
+template<>
+struct plus<void>
+{
+  template<typename T, typename U>
+  auto operator()(T&& a, U&& b) const
+    -> decltype(std::forward<T>(a) + std::forward<U>(b))
+  {
+    return std::forward<T>(a) + std::forward<U>(b);
+  }
+};
+
+
+template<typename T = void>
+struct multiplies
+{
+  T operator()(T const& a, T const& b) const { return a * b; }
+};
+
+template<>
+struct multiplies<void>
+{
+  template<typename T, typename U>
+  auto operator()(T&& a, U&& b) const
+    -> decltype(std::forward<T>(a) * std::forward<U>(b))
+  {
+    return std::forward<T>(a) * std::forward<U>(b);
+  }
+};
+
+
 } // namespace stl
 
 #endif
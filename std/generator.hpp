@@ -0,0 +1,252 @@
+
+#ifndef STL_GENERATOR_HPP
+#define STL_GENERATOR_HPP
+
+#include "view.hpp"
+
+#if !defined(__cpp_impl_coroutine)
+#  error "stl::generator requires coroutines (-fcoroutines)"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace stl
+{
+
+// Generator
+//
+// A lazy input range of the values yielded by a coroutine:
+//
+//    generator<int> iota(int n)
+//    {
+//      for (int i = 0; i < n; ++i)
+//        co_yield i;
+//    }
+//
+// The coroutine starts when begin() is called, and runs to the next
+// co_yield on every increment. It is at the end when the coroutine
+// returns, so the end of the range is default_sentinel. An exception
+// thrown by the coroutine is rethrown by begin() or the increment.
+//
+// Values are yielded by reference: the iterator refers to the object
+// named in the co_yield, which lives until the coroutine is resumed, so
+// nothing is copied. The reference type of generator<T> is T const&, or
+// T itself when T is a reference type.
+//
+// The coroutine frame is allocated with A, once per generator. A
+// stateful allocator is passed to the coroutine after
+// std::allocator_arg, and is stored in the frame:
+//
+//    generator<int, arena_allocator<char>>
+//    numbers(std::allocator_arg_t, arena_allocator<char> a);
+//
+// A generator is a move-only view, so an rvalue generator can be
+// adapted by the views. It may not co_await.
+
+template<typename T, typename A = std::allocator<char>>
+class generator : public view_base
+{
+public:
+  class promise_type;
+  class iterator;
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  generator() = default;
+
+  generator(generator&& g)
+    : coro(std::exchange(g.coro, nullptr))
+  { }
+
+  generator& operator=(generator&& g)
+  {
+    generator tmp(std::move(g));
+    std::swap(coro, tmp.coro);
+    return *this;
+  }
+
+  ~generator()
+  {
+    if (coro)
+      coro.destroy();
+  }
+
+  iterator begin();
+  default_sentinel end() { return {}; }
+
+private:
+  explicit generator(handle_type h)
+    : coro(h)
+  { }
+
+  handle_type coro = nullptr;
+};
+
+
+// The frame is allocated in blocks of the default new alignment, with
+// the allocator stored at the end.
+template<typename T, typename A>
+class generator<T, A>::promise_type
+{
+  struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) block
+  {
+    char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+  };
+
+  using allocator = typename std::allocator_traits<A>::template rebind_alloc<block>;
+  using traits = std::allocator_traits<allocator>;
+
+  static std::size_t offset(std::size_t n)
+  {
+    return (n + alignof(allocator) - 1) / alignof(allocator) * alignof(allocator);
+  }
+
+  static std::size_t blocks(std::size_t n)
+  {
+    return (offset(n) + sizeof(allocator) + sizeof(block) - 1) / sizeof(block);
+  }
+
+  static void* allocate(allocator a, std::size_t n)
+  {
+    void* p = traits::allocate(a, blocks(n));
+    ::new (static_cast<char*>(p) + offset(n)) allocator(std::move(a));
+    return p;
+  }
+
+public:
+  using value_type = remove_cv_t<remove_reference_t<T>>;
+  using reference = conditional_t<is_reference_v<T>, T, T const&>;
+
+  static void* operator new(std::size_t n)
+  {
+    return allocate(allocator(A()), n);
+  }
+
+  template<typename... Args>
+  static void* operator new(std::size_t n, std::allocator_arg_t, A const& a, Args const&...)
+  {
+    return allocate(allocator(a), n);
+  }
+
+  static void operator delete(void* p, std::size_t n)
+  {
+    allocator* s = reinterpret_cast<allocator*>(static_cast<char*>(p) + offset(n));
+    allocator a(std::move(*s));
+    s->~allocator();
+    traits::deallocate(a, static_cast<block*>(p), blocks(n));
+  }
+
+  generator get_return_object()
+  {
+    return generator(handle_type::from_promise(*this));
+  }
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  std::suspend_always final_suspend() const noexcept { return {}; }
+
+  std::suspend_always yield_value(reference x) noexcept
+  {
+    value = std::addressof(x);
+    return {};
+  }
+
+  void return_void() const noexcept { }
+
+  void unhandled_exception() { error = std::current_exception(); }
+
+  template<typename U>
+  void await_transform(U&&) = delete;
+
+  reference get() const { return static_cast<reference>(*value); }
+
+  void rethrow()
+  {
+    if (error)
+      std::rethrow_exception(std::exchange(error, nullptr));
+  }
+
+private:
+  remove_reference_t<reference>* value = nullptr;
+  std::exception_ptr error;
+};
+
+
+template<typename T, typename A>
+class generator<T, A>::iterator
+{
+public:
+  using value_type = typename promise_type::value_type;
+  using reference = typename promise_type::reference;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = input_iterator_tag;
+
+  // The result of i++, which holds a copy of the value yielded before
+  // the coroutine was resumed.
+  class proxy
+  {
+  public:
+    using value_type = typename promise_type::value_type;
+
+    proxy() = default;
+    explicit proxy(reference x) : val(x) { }
+
+    value_type const& operator*() const { return val; }
+
+  private:
+    value_type val;
+  };
+
+  iterator() = default;
+
+  explicit iterator(handle_type h)
+    : coro(h)
+  { }
+
+  reference operator*() const { return coro.promise().get(); }
+
+  iterator& operator++()
+  {
+    coro.resume();
+    coro.promise().rethrow();
+    return *this;
+  }
+
+  proxy operator++(int)
+  {
+    proxy p(**this);
+    ++*this;
+    return p;
+  }
+
+  friend bool operator==(iterator const& i, default_sentinel) { return i.at_end(); }
+  friend bool operator==(default_sentinel, iterator const& i) { return i.at_end(); }
+  friend bool operator!=(iterator const& i, default_sentinel) { return !i.at_end(); }
+  friend bool operator!=(default_sentinel, iterator const& i) { return !i.at_end(); }
+
+private:
+  bool at_end() const { return !coro || coro.done(); }
+
+  handle_type coro = nullptr;
+};
+
+
+template<typename T, typename A>
+auto
+generator<T, A>::begin() -> iterator
+{
+  if (coro) {
+    coro.resume();
+    coro.promise().rethrow();
+  }
+  return iterator(coro);
+}
+
+} // namespace stl
+
+#endif
@@ -0,0 +1,2 @@
+
+#include "hash.hpp"
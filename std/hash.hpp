@@ -0,0 +1,526 @@
+
+#ifndef STL_HASH_HPP
+#define STL_HASH_HPP
+
+#include "concepts.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace stl
+{
+
+// Hashing
+//
+// Hashing is split in two. A type describes the bytes of its values
+// once, by overloading hash_append, and a hash algorithm turns the bytes
+// into a hash:
+//
+//    struct key
+//    {
+//      std::int64_t id;
+//      std::string name;
+//
+//      template<HashAlgorithm H>
+//      friend void hash_append(H& h, key const& k)
+//      {
+//        using stl::hash_append;
+//        hash_append(h, k.id, k.name);
+//      }
+//    };
+//
+//    stl::hash<key> h;                 // wyhash
+//    stl::hash<key, stl::fnv1a> h2;
+//
+// A composite key is hashed in one pass by one algorithm, rather than by
+// hashing its fields separately and combining the results.
+//
+// Values whose bytes are all significant, such as integers, pointers,
+// and enumerations (see is_uniquely_represented) are appended as bytes,
+// and so are pairs, tuples, arrays, strings, and vectors of them, with
+// no padding. Other types are appended element by element. A sequence of
+// variable length is followed by its length, so that, e.g., ("ab", "c")
+// and ("a", "bc") differ.
+//
+// Equal values of the same type have the same bytes, but values of
+// different types need not, even if they compare equal.
+
+
+// Uniquely represented types
+//
+// A type is uniquely represented when equal values have equal bytes and
+// there is no padding. This is true of integers, enumerations and
+// pointers, and of pairs, tuples, and arrays of them that have no padding.
+// It may be specialized for other trivially copyable types, e.g., a
+// struct of integers that has no padding.
+
+template<typename T>
+struct is_uniquely_represented
+  : boolean_constant<Integral<T>() || std::is_enum<T>::value || std::is_pointer<T>::value>
+{ };
+
+template<typename T>
+struct is_uniquely_represented<T const> : is_uniquely_represented<T>
+{ };
+
+template<typename T, typename U>
+struct is_uniquely_represented<std::pair<T, U>>
+  : boolean_constant<is_uniquely_represented<T>::value &&
+                     is_uniquely_represented<U>::value &&
+                     sizeof(T) + sizeof(U) == sizeof(std::pair<T, U>)>
+{ };
+
+template<typename... Ts>
+struct is_uniquely_represented<std::tuple<Ts...>>
+  : boolean_constant<(is_uniquely_represented<Ts>::value && ...) &&
+                     (sizeof(Ts) + ... + 0) == sizeof(std::tuple<Ts...>)>
+{ };
+
+template<typename T, std::size_t N>
+struct is_uniquely_represented<T[N]> : is_uniquely_represented<T>
+{ };
+
+template<typename T, std::size_t N>
+struct is_uniquely_represented<std::array<T, N>>
+  : boolean_constant<is_uniquely_represented<T>::value &&
+                     sizeof(T) * N == sizeof(std::array<T, N>)>
+{ };
+
+
+template<typename T>
+concept bool UniquelyRepresented()
+{
+  return is_uniquely_represented<T>::value;
+}
+
+
+// Hash algorithms
+//
+// A hash algorithm h is fed bytes by h(p, n), and its result is given by
+// converting it to its result_type.
+
+template<typename H>
+concept bool HashAlgorithm()
+{
+  return requires (H& h, void const* p, std::size_t n) {
+    typename H::result_type;
+    h(p, n);
+    static_cast<typename H::result_type>(h);
+  };
+}
+
+
+namespace impl
+{
+
+inline std::uint64_t
+load8(unsigned char const* p)
+{
+  std::uint64_t x;
+  std::memcpy(&x, p, 8);
+  return x;
+}
+
+inline std::uint64_t
+load4(unsigned char const* p)
+{
+  std::uint32_t x;
+  std::memcpy(&x, p, 4);
+  return x;
+}
+
+// Returns the n <= 8 bytes at p as the low bytes of a word, without
+// reading past them.
+inline std::uint64_t
+load_short(unsigned char const* p, std::size_t n)
+{
+  if (n == 8)
+    return load8(p);
+  if (n >= 4)
+    return load4(p) | (load4(p + n - 4) << (8 * (n - 4)));
+  if (n > 0)
+    return std::uint64_t(p[0]) | (std::uint64_t(p[n >> 1]) << (8 * (n >> 1))) |
+           (std::uint64_t(p[n - 1]) << (8 * (n - 1)));
+  return 0;
+}
+
+// Returns the low and high halves of a * b, xored.
+inline std::uint64_t
+mix(std::uint64_t a, std::uint64_t b)
+{
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+}
+
+} // namespace impl
+
+
+// Wyhash
+//
+// Wang Yi's wyhash (final version 4). It reads the input 16 or 48 bytes
+// at a time and mixes them with 64 by 64 to 128 bit multiplies, so keys
+// of up to 16 bytes take two multiplies.
+//
+// Appends are collected in a 16 byte block, which is mixed when it is
+// full and more follows, and the final round is done once, on the last
+// block. An append of up to 8 bytes fills half of the block, so a key of
+// several small fields takes about one multiply per two fields, not two
+// per field. A longer append is mixed as wyhash mixes its input, and its
+// last 16 bytes are the block. Appending a whole key at once gives the
+// same result as wyhash; appending it in pieces gives a different,
+// equally good, one.
+
+class wyhash
+{
+public:
+  using result_type = std::uint64_t;
+
+  explicit wyhash(std::uint64_t seed = 0) noexcept
+    : seed(seed ^ impl::mix(seed ^ secret[0], secret[1]))
+  { }
+
+  void operator()(void const* data, std::size_t n) noexcept;
+
+  explicit operator result_type() const noexcept;
+
+private:
+  static constexpr std::uint64_t secret[4] {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+  };
+
+  static std::uint64_t absorb(unsigned char const* p, std::size_t n,
+                              std::uint64_t seed, std::uint64_t& a,
+                              std::uint64_t& b) noexcept;
+
+  std::uint64_t seed;
+  std::uint64_t length = 0;
+
+  // The block, of which the first used words are filled.
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  int used = 0;
+};
+
+inline void
+wyhash::operator()(void const* data, std::size_t n) noexcept
+{
+  auto p = static_cast<unsigned char const*>(data);
+  if (n == 0)
+    return;
+  length += n;
+  if (used == 2 || (used == 1 && n > 8)) {
+    seed = impl::mix(a ^ secret[1], b ^ seed);
+    b = 0;
+    used = 0;
+  }
+  if (n <= 8) {
+    (used == 0 ? a : b) = impl::load_short(p, n);
+    ++used;
+  } else {
+    std::uint64_t x;
+    std::uint64_t y;
+    seed = absorb(p, n, seed, x, y);
+    a = x;
+    b = y;
+    used = 2;
+  }
+}
+
+// Mixes all but the last 16 of n > 8 bytes into seed, as wyhash does,
+// and returns the new seed and, in a and b, the last 16 bytes. The state
+// is passed by value so that it can stay in registers in the callers.
+inline std::uint64_t
+wyhash::absorb(unsigned char const* p, std::size_t n, std::uint64_t seed,
+               std::uint64_t& a, std::uint64_t& b) noexcept
+{
+  if (n <= 16) {
+    std::size_t k = (n >> 3) << 2;
+    a = (impl::load4(p) << 32) | impl::load4(p + k);
+    b = (impl::load4(p + n - 4) << 32) | impl::load4(p + n - 4 - k);
+    return seed;
+  }
+  if (n > 48) {
+    std::uint64_t see1 = seed;
+    std::uint64_t see2 = seed;
+    do {
+      seed = impl::mix(impl::load8(p) ^ secret[1], impl::load8(p + 8) ^ seed);
+      see1 = impl::mix(impl::load8(p + 16) ^ secret[2], impl::load8(p + 24) ^ see1);
+      see2 = impl::mix(impl::load8(p + 32) ^ secret[3], impl::load8(p + 40) ^ see2);
+      p += 48;
+      n -= 48;
+    } while (n > 48);
+    seed ^= see1 ^ see2;
+  }
+  while (n > 16) {
+    seed = impl::mix(impl::load8(p) ^ secret[1], impl::load8(p + 8) ^ seed);
+    p += 16;
+    n -= 16;
+  }
+  a = impl::load8(p + n - 16);
+  b = impl::load8(p + n - 8);
+  return seed;
+}
+
+// A block holding only one short append is read as wyhash reads keys of
+// up to 8 bytes.
+inline
+wyhash::operator result_type() const noexcept
+{
+  std::uint64_t x = a;
+  std::uint64_t y = b;
+  if (used == 1 && length <= 8) {
+    std::size_t n = length;
+    auto byte = [x](std::size_t k) { return (x >> (8 * k)) & 0xff; };
+    auto word = [x](std::size_t k) { return (x >> (8 * k)) & 0xffffffff; };
+    if (n >= 4) {
+      std::size_t k = (n >> 3) << 2;
+      x = (word(0) << 32) | word(k);
+      y = (word(n - 4) << 32) | word(n - 4 - k);
+    } else {
+      x = (byte(0) << 16) | (byte(n >> 1) << 8) | byte(n - 1);
+      y = 0;
+    }
+  }
+  x ^= secret[1];
+  y ^= seed;
+  unsigned __int128 r = static_cast<unsigned __int128>(x) * y;
+  x = static_cast<std::uint64_t>(r);
+  y = static_cast<std::uint64_t>(r >> 64);
+  return impl::mix(x ^ secret[0] ^ length, y ^ secret[1]);
+}
+
+
+// FNV-1a
+//
+// The 64-bit Fowler-Noll-Vo hash. It takes a multiply per byte, so it is
+// much slower than wyhash on long inputs, but it is simple and its
+// results are the same on every platform.
+
+class fnv1a
+{
+public:
+  using result_type = std::uint64_t;
+
+  void operator()(void const* data, std::size_t n) noexcept
+  {
+    auto p = static_cast<unsigned char const*>(data);
+    for (std::size_t i = 0; i < n; ++i)
+      state = (state ^ p[i]) * 0x100000001b3ull;
+  }
+
+  explicit operator result_type() const noexcept { return state; }
+
+private:
+  std::uint64_t state = 0xcbf29ce484222325ull;
+};
+
+
+// Hash append
+//
+// All of the overloads are declared before any is defined, so that the
+// ones for composites find those for their elements.
+
+template<HashAlgorithm H, UniquelyRepresented T>
+void hash_append(H& h, T const& x) noexcept;
+
+template<HashAlgorithm H, typename T>
+  requires std::is_floating_point<T>::value
+void hash_append(H& h, T x) noexcept;
+
+template<HashAlgorithm H>
+void hash_append(H& h, std::nullptr_t) noexcept;
+
+template<HashAlgorithm H, typename T, std::size_t N>
+  requires !UniquelyRepresented<T[N]>()
+void hash_append(H& h, T const (&a)[N]);
+
+template<HashAlgorithm H, typename T, typename U>
+  requires !UniquelyRepresented<std::pair<T, U>>()
+void hash_append(H& h, std::pair<T, U> const& p);
+
+template<HashAlgorithm H, typename... Ts>
+  requires !UniquelyRepresented<std::tuple<Ts...>>()
+void hash_append(H& h, std::tuple<Ts...> const& t);
+
+template<HashAlgorithm H, typename T, std::size_t N>
+  requires !UniquelyRepresented<std::array<T, N>>()
+void hash_append(H& h, std::array<T, N> const& a);
+
+template<HashAlgorithm H, typename C, typename T>
+void hash_append(H& h, std::basic_string_view<C, T> s) noexcept;
+
+template<HashAlgorithm H, typename C, typename T, typename A>
+void hash_append(H& h, std::basic_string<C, T, A> const& s) noexcept;
+
+template<HashAlgorithm H, typename T, typename A>
+void hash_append(H& h, std::vector<T, A> const& v);
+
+template<HashAlgorithm H, typename T, typename U, typename... Ts>
+void hash_append(H& h, T const& x, U const& y, Ts const&... rest);
+
+
+namespace impl
+{
+
+// Appends the n elements at p, as one block of bytes if they are
+// uniquely represented.
+template<typename H, typename T>
+void
+hash_append_range(H& h, T const* p, std::size_t n)
+{
+  if constexpr (UniquelyRepresented<T>()) {
+    h(p, n * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < n; ++i)
+      hash_append(h, p[i]);
+  }
+}
+
+} // namespace impl
+
+
+template<HashAlgorithm H, UniquelyRepresented T>
+inline void
+hash_append(H& h, T const& x) noexcept
+{
+  h(std::addressof(x), sizeof(x));
+}
+
+// Zeros of either sign compare equal, so they are hashed alike. A long
+// double may have padding, so it is hashed as a double.
+template<HashAlgorithm H, typename T>
+  requires std::is_floating_point<T>::value
+inline void
+hash_append(H& h, T x) noexcept
+{
+  if constexpr (std::is_same<T, long double>::value) {
+    hash_append(h, static_cast<double>(x));
+  } else {
+    if (x == 0)
+      x = 0;
+    h(std::addressof(x), sizeof(x));
+  }
+}
+
+template<HashAlgorithm H>
+inline void
+hash_append(H& h, std::nullptr_t) noexcept
+{
+  void const* p = nullptr;
+  hash_append(h, p);
+}
+
+template<HashAlgorithm H, typename T, std::size_t N>
+  requires !UniquelyRepresented<T[N]>()
+inline void
+hash_append(H& h, T const (&a)[N])
+{
+  impl::hash_append_range(h, a, N);
+}
+
+template<HashAlgorithm H, typename T, typename U>
+  requires !UniquelyRepresented<std::pair<T, U>>()
+inline void
+hash_append(H& h, std::pair<T, U> const& p)
+{
+  hash_append(h, p.first, p.second);
+}
+
+template<HashAlgorithm H, typename... Ts>
+  requires !UniquelyRepresented<std::tuple<Ts...>>()
+inline void
+hash_append(H& h, std::tuple<Ts...> const& t)
+{
+  std::apply([&h](Ts const&... xs) { (hash_append(h, xs), ...); }, t);
+}
+
+template<HashAlgorithm H, typename T, std::size_t N>
+  requires !UniquelyRepresented<std::array<T, N>>()
+inline void
+hash_append(H& h, std::array<T, N> const& a)
+{
+  impl::hash_append_range(h, a.data(), N);
+}
+
+template<HashAlgorithm H, typename C, typename T>
+inline void
+hash_append(H& h, std::basic_string_view<C, T> s) noexcept
+{
+  h(s.data(), s.size() * sizeof(C));
+  hash_append(h, s.size());
+}
+
+template<HashAlgorithm H, typename C, typename T, typename A>
+inline void
+hash_append(H& h, std::basic_string<C, T, A> const& s) noexcept
+{
+  hash_append(h, std::basic_string_view<C, T>(s));
+}
+
+template<HashAlgorithm H, typename T, typename A>
+inline void
+hash_append(H& h, std::vector<T, A> const& v)
+{
+  impl::hash_append_range(h, v.data(), v.size());
+  hash_append(h, v.size());
+}
+
+template<HashAlgorithm H, typename T, typename U, typename... Ts>
+inline void
+hash_append(H& h, T const& x, U const& y, Ts const&... rest)
+{
+  hash_append(h, x);
+  hash_append(h, y);
+  (hash_append(h, rest), ...);
+}
+
+
+// Hash function objects
+//
+// hash<T, H> hashes a T with a new H, and returns the result as a
+// size_t, so it can be used with the standard unordered containers.
+// hash<void, H> hashes values of any type, and is transparent.
+
+template<typename T>
+concept bool Hashable()
+{
+  return requires (wyhash& h, T const& x) { hash_append(h, x); };
+}
+
+
+template<typename T = void, HashAlgorithm H = wyhash>
+struct hash
+{
+  std::size_t operator()(T const& x) const noexcept
+  {
+    H h;
+    hash_append(h, x);
+    return static_cast<std::size_t>(static_cast<typename H::result_type>(h));
+  }
+};
+
+template<HashAlgorithm H>
+struct hash<void, H>
+{
+  using is_transparent = void;
+
+  template<Hashable T>
+  std::size_t operator()(T const& x) const noexcept
+  {
+    return hash<T, H>()(x);
+  }
+};
+
+} // namespace stl
+
+#endif
@@ -3,10 +3,11 @@
 #define STL_ITERATOR_HPP
 
 #include "concepts.hpp"
-#include "functional.hpp" // for mem_fn
+#include "functional.hpp"
 
 #include <cstddef>
 #include <iterator>
+#include <new>
 
 
 namespace stl
@@ -187,13 +188,42 @@ concept bool RandomAccessIterator()
 }
 
 
+// Contiguous iterators are random access iterators whose elements are
+// laid out in adjacent objects in memory. That cannot be deduced from
+// the iterator's interface (a deque's iterators look exactly like a
+// vector's), so iterator types opt in.
+template<typename I>
+constexpr bool enable_contiguous_iterator = false;
+
+template<typename T>
+constexpr bool enable_contiguous_iterator<T*> = true;
+
+// The iterators of std::vector, std::string, etc.
+#if defined(__GLIBCXX__)
+template<typename T, typename C>
+constexpr bool enable_contiguous_iterator<__gnu_cxx::__normal_iterator<T*, C>> = true;
+#endif
+
+
+template<typename I>
+concept bool ContiguousIterator()
+{
+  return RandomAccessIterator<I>() &&
+    enable_contiguous_iterator<remove_cv_t<I>> &&
+    is_lvalue_reference_v<reference_t<I>> &&
+    SameAs<value_type_t<I>, remove_cv_t<remove_reference_t<reference_t<I>>>>();
+}
+
+
 // As function
 
 template<typename T>
   requires is_member_pointer_v<decay_t<T>>
 auto get_as_function(T&& t)
 {
-  return std::mem_fn(t);
+  return [m = t](auto&&... args) -> decltype(auto) {
+    return stl::invoke(m, std::forward<decltype(args)>(args)...);
+  };
 }
 
 template<typename T>
@@ -211,7 +241,8 @@ using as_function_t = decltype(get_as_function(std::declval<T>()));
 template<typename F, Readable... Iters>
 concept bool IndirectlyCallable()
 {
-  return Callable<F, value_type_t<Iters>...>();
+  return Callable<F, value_type_t<Iters>...>()
+      && Callable<F, reference_t<Iters>...>();
 }
 
 
@@ -257,7 +288,7 @@ struct indirect_result_of;
 
 template<typename F, typename... Iters>
   requires IndirectlyCallable<remove_reference_t<F>, Iters...>()
-struct indirect_result_of<F(Iters...)> : result_of_t<F(value_type<Iters>...)>
+struct indirect_result_of<F(Iters...)> : invoke_result<F, reference_t<Iters>...>
 { };
 
 template<typename C>
@@ -272,7 +303,7 @@ struct projected
 {
   using value_type = decay_t<indirect_result_of_t<P&(I)>>;
 
-  result_of_t<P&(reference_t<I>)> operator*() const;
+  invoke_result_t<P&, reference_t<I>> operator*() const;
 };
 
 
@@ -358,13 +389,11 @@ concept bool Mergeable()
 }
 
 
-// FIXME: Non-conforming.
-template<typename I>
+template<typename I, typename R = less<>, typename P = identity_fn>
 concept bool Sortable()
 {
   return Permutable<I>() &&
-    RandomAccessIterator<I>() &&
-    TotallyOrdered<value_type_t<I>>();
+    IndirectStrictWeakOrder<R, projected<I, P>, projected<I, P>>();
 }
 
 // Advance
@@ -391,8 +420,6 @@ void advance(I& iter, difference_type_t<I> n = 1)
 }
 
 // FIXME: I don't understand the assignable bits in the specification.
-//
-// TODO: Specialize for sized sentinels.
 template<Iterator I, Sentinel<I> S>
 void advance(I& iter, S bound)
 {
@@ -400,7 +427,20 @@ void advance(I& iter, S bound)
     ++iter;
 }
 
-// TODO: Optimize for sized sentinels.
+// When the distance to the bound can be computed, move that many
+// steps. This is constant time for random access iterators.
+template<Iterator I, SizedSentinel<I> S>
+void advance(I& iter, S bound)
+{
+  stl::advance(iter, bound - iter);
+}
+
+template<Iterator I>
+void advance(I& iter, I bound)
+{
+  iter = bound;
+}
+
 template<Iterator I, Sentinel<I> S>
 void advance(I& iter, difference_type_t<I> n, S bound)
 {
@@ -416,27 +456,46 @@ void advance(I& iter, difference_type_t<I> n, S bound)
     while (n != 0 && iter != bound) { --iter; ++n; }
 }
 
+// For sized sentinels, clamp n to the distance to the bound and move
+// that many steps, without comparing against the bound on each step.
+template<Iterator I, SizedSentinel<I> S>
+void advance(I& iter, difference_type_t<I> n, S bound)
+{
+  difference_type_t<I> d = bound - iter;
+  stl::advance(iter, n < d ? n : d);
+}
+
+template<BidirectionalIterator I, SizedSentinel<I> S>
+void advance(I& iter, difference_type_t<I> n, S bound)
+{
+  difference_type_t<I> d = bound - iter;
+  if (n > 0)
+    stl::advance(iter, n < d ? n : d);
+  else
+    stl::advance(iter, n > d ? n : d);
+}
+
 
 // Next
 
 template<Iterator I>
-I next(I& iter, difference_type_t<I> n = 1)
+I next(I iter, difference_type_t<I> n = 1)
 {
-  advance(iter, n);
+  stl::advance(iter, n);
   return iter;
 }
 
 template<Iterator I, Sentinel<I> S>
-I next(I& iter, S bound)
+I next(I iter, S bound)
 {
-  advance(iter, bound);
+  stl::advance(iter, bound);
   return iter;
 }
 
 template<Iterator I, Sentinel<I> S>
-I next(I& iter, difference_type_t<I> n, S bound)
+I next(I iter, difference_type_t<I> n, S bound)
 {
-  advance(iter, n, bound);
+  stl::advance(iter, n, bound);
   return iter;
 }
 
@@ -444,20 +503,38 @@ I next(I& iter, difference_type_t<I> n, S bound)
 // Prev
 
 template<BidirectionalIterator I>
-I prev(I& iter, difference_type_t<I> n = 1)
+I prev(I iter, difference_type_t<I> n = 1)
 {
-  advance(iter, -n);
+  stl::advance(iter, -n);
   return iter;
 }
 
 template<BidirectionalIterator I, Sentinel<I> S>
-I prev(I& iter, difference_type_t<I> n, S bound)
+I prev(I iter, difference_type_t<I> n, S bound)
 {
-  advance(iter, -n, bound);
+  stl::advance(iter, -n, bound);
   return iter;
 }
 
 
+// Distance
+
+template<Iterator I, Sentinel<I> S>
+difference_type_t<I> distance(I first, S last)
+{
+  difference_type_t<I> n = 0;
+  for (; first != last; ++first)
+    ++n;
+  return n;
+}
+
+template<Iterator I, SizedSentinel<I> S>
+difference_type_t<I> distance(I first, S last)
+{
+  return last - first;
+}
+
+
 // Reverse iterator
 
 template<BidirectionalIterator I>
@@ -479,7 +556,7 @@ struct reverse_iterator
 
   I base() const { return iter; }
   reference operator*() const;
-  I operator->() const { return prev(iter); }
+  I operator->() const { return stl::prev(iter); }
 
   reverse_iterator& operator++();
   reverse_iterator& operator--();
@@ -501,7 +578,7 @@ template<BidirectionalIterator I>
 inline auto
 reverse_iterator<I>::operator*() const -> reference
 {
-  return *prev(iter);
+  return *stl::prev(iter);
 }
 
 template<BidirectionalIterator I>
@@ -975,7 +1052,219 @@ operator-(move_iterator<I> const& i, difference_type_t<I> n)
 
 // Common iterator
 //
-// TODO: Implement me.
+// Either an iterator or a sentinel, with a common type, so that a range
+// whose sentinel type differs from its iterator type can be passed to
+// algorithms that require a bounded range. The iterator and sentinel
+// share storage, and a flag tells which one is present.
+//
+// Comparing a common iterator that holds a sentinel with one that holds
+// an iterator compares the sentinel with the iterator. Two sentinels
+// are equal. Two iterators are compared if they can be, and are
+// otherwise equal (they cannot both be valid input iterators).
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+class common_iterator
+{
+public:
+  using value_type        = value_type_t<I>;
+  using reference         = reference_t<I>;
+  using difference_type   = difference_type_t<I>;
+  using pointer           = void;
+  using iterator_category = conditional_t<ForwardIterator<I>(),
+                                          forward_iterator_tag,
+                                          input_iterator_tag>;
+
+  common_iterator();
+  common_iterator(I i);
+  common_iterator(S s);
+
+  common_iterator(common_iterator const&);
+  common_iterator& operator=(common_iterator const&);
+  ~common_iterator();
+
+  bool is_sentinel() const { return sent; }
+
+  reference operator*() const { return *u.iter; }
+
+  common_iterator& operator++();
+  common_iterator operator++(int);
+
+  bool equal(common_iterator const&) const;
+  difference_type distance(common_iterator const&) const
+    requires SizedSentinel<S, I>() && SizedSentinel<I, I>();
+
+private:
+  void construct(common_iterator const&);
+  void destroy();
+
+  union storage
+  {
+    storage() { }
+    ~storage() { }
+
+    I iter;
+    S last;
+  } u;
+  bool sent;
+};
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline
+common_iterator<I, S>::common_iterator()
+  : sent(false)
+{
+  new (&u.iter) I();
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline
+common_iterator<I, S>::common_iterator(I i)
+  : sent(false)
+{
+  new (&u.iter) I(std::move(i));
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline
+common_iterator<I, S>::common_iterator(S s)
+  : sent(true)
+{
+  new (&u.last) S(std::move(s));
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline void
+common_iterator<I, S>::construct(common_iterator const& x)
+{
+  sent = x.sent;
+  if (sent)
+    new (&u.last) S(x.u.last);
+  else
+    new (&u.iter) I(x.u.iter);
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline void
+common_iterator<I, S>::destroy()
+{
+  if (sent)
+    u.last.~S();
+  else
+    u.iter.~I();
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline
+common_iterator<I, S>::common_iterator(common_iterator const& x)
+{
+  construct(x);
+}
+
+// Assigning an iterator to an iterator (the common case in loops) is
+// a plain assignment.
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline auto
+common_iterator<I, S>::operator=(common_iterator const& x) -> common_iterator&
+{
+  if (!sent && !x.sent) {
+    u.iter = x.u.iter;
+  } else if (sent && x.sent) {
+    u.last = x.u.last;
+  } else {
+    destroy();
+    construct(x);
+  }
+  return *this;
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline
+common_iterator<I, S>::~common_iterator()
+{
+  destroy();
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline auto
+common_iterator<I, S>::operator++() -> common_iterator&
+{
+  ++u.iter;
+  return *this;
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline auto
+common_iterator<I, S>::operator++(int) -> common_iterator
+{
+  common_iterator tmp = *this;
+  ++u.iter;
+  return tmp;
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline bool
+common_iterator<I, S>::equal(common_iterator const& x) const
+{
+  if (sent)
+    return x.sent || x.u.iter == u.last;
+  if (x.sent)
+    return u.iter == x.u.last;
+  if constexpr (EqualityComparable<I>())
+    return u.iter == x.u.iter;
+  else
+    return true;
+}
+
+template<Iterator I, Sentinel<I> S>
+  requires !SameAs<I, S>()
+inline auto
+common_iterator<I, S>::distance(common_iterator const& x) const -> difference_type
+  requires SizedSentinel<S, I>() && SizedSentinel<I, I>()
+{
+  if (sent)
+    return x.sent ? 0 : u.last - x.u.iter;
+  if (x.sent)
+    return u.iter - x.u.last;
+  return u.iter - x.u.iter;
+}
+
+// Equality
+
+template<typename I, typename S>
+inline bool
+operator==(common_iterator<I, S> const& a, common_iterator<I, S> const& b)
+{
+  return a.equal(b);
+}
+
+template<typename I, typename S>
+inline bool
+operator!=(common_iterator<I, S> const& a, common_iterator<I, S> const& b)
+{
+  return !a.equal(b);
+}
+
+// Difference
+
+template<typename I, typename S>
+  requires SizedSentinel<S, I>() && SizedSentinel<I, I>()
+inline difference_type_t<I>
+operator-(common_iterator<I, S> const& a, common_iterator<I, S> const& b)
+{
+  return a.distance(b);
+}
 
 
 
@@ -1079,7 +1368,7 @@ struct counted_iterator
   counted_iterator& operator=(counted_iterator<J> const&);
 
   I base() const { return iter; }
-  difference_type count() const { return count; }
+  difference_type count() const { return cnt; }
   reference operator*() const { return *iter; }
 
   counted_iterator& operator++();
@@ -1122,6 +1411,7 @@ counted_iterator<I>::operator=(counted_iterator<J> const& i) -> counted_iterator
 {
   iter = i.iter;
   cnt = i.cnt;
+  return *this;
 }
 
 template<Iterator I>
@@ -1140,6 +1430,7 @@ counted_iterator<I>::operator--() -> counted_iterator&
 {
   --iter;
   ++cnt;
+  return *this;
 }
 
 template<Iterator I>
@@ -1149,7 +1440,7 @@ counted_iterator<I>::operator++(int) -> counted_iterator
   counted_iterator tmp = *this;
   ++iter;
   --cnt;
-  return *this;
+  return tmp;
 }
 
 template<Iterator I>
@@ -1160,7 +1451,7 @@ counted_iterator<I>::operator--(int) -> counted_iterator
   counted_iterator tmp = *this;
   --iter;
   ++cnt;
-  return *this;
+  return tmp;
 }
 
 template<Iterator I>
@@ -1352,12 +1643,45 @@ operator>=(default_sentinel, counted_iterator<I> i)
 }
 
 
-// Dangling wrapper
+// Segmented iterators
 //
-// TODO: Implement me.
+// A segmented iterator traverses a sequence of segments, each of which
+// is a range of local iterators, as a deque traverses its blocks or a
+// joined range its inner ranges. Algorithms use its traits to run an
+// inner loop over the local iterators of each segment, so that the
+// segment boundary is not checked on every increment.
+//
+// The traits of a segmented iterator I provide:
+//
+//    segment_iterator and local_iterator
+//    segment(i) and local(i), the segment of i and its position there
+//    begin(s) and end(s), the local range of the segment s
+//    compose(i, s, l), the iterator at l in the segment s, where i is
+//      any iterator into the same sequence
+//    has_segment(i), false when i is past the last segment
+//
+// An iterator type opts in by defining a nested segment_traits type.
+// The traits of a deque's iterators are in algorithm.hpp.
+
+template<typename I>
+struct segmented_iterator_traits
+{
+  static constexpr bool is_segmented = false;
+};
+
+template<typename I>
+  requires requires { typename I::segment_traits; }
+struct segmented_iterator_traits<I> : I::segment_traits
+{ };
 
+template<typename I>
+concept bool SegmentedIterator()
+{
+  return Iterator<I>() && segmented_iterator_traits<I>::is_segmented;
+}
 
-// Stream iterators
+
+// Dangling wrapper
 //
 // TODO: Implement me.
 
@@ -0,0 +1,2 @@
+
+#include "mmap.hpp"
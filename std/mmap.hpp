@@ -0,0 +1,156 @@
+
+#ifndef STL_MMAP_HPP
+#define STL_MMAP_HPP
+
+#include "range.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace stl
+{
+
+// Memory-mapped file
+//
+// A read-only mapping of a file, as a contiguous range of its bytes. The
+// pages are read by the kernel as they are touched, so a file of any
+// size can be searched and traversed by the algorithms and views with
+// no buffered copy.
+//
+// The advice tells the kernel how the pages will be accessed. With
+// sequential access, it reads ahead aggressively and may drop pages
+// that have been passed; with random access, it does not read ahead.
+//
+// The range owns the mapping and may be moved but not copied. Failing
+// to open or map the file throws std::system_error. An empty file is
+// an empty range.
+//
+// NOTE: Changes to the file by other processes while it is mapped are
+// visible through the range, and truncating it makes accesses past the
+// new end fault.
+
+enum class mmap_advice
+{
+  normal,
+  sequential,
+  random,
+  willneed,
+};
+
+
+class mmap_range
+{
+public:
+  using value_type = char;
+  using iterator   = char const*;
+
+  mmap_range() = default;
+  explicit mmap_range(char const* path, mmap_advice a = mmap_advice::sequential);
+  explicit mmap_range(std::string const& path, mmap_advice a = mmap_advice::sequential)
+    : mmap_range(path.c_str(), a)
+  { }
+
+  mmap_range(mmap_range&& x)
+    : ptr(std::exchange(x.ptr, nullptr)), len(std::exchange(x.len, 0))
+  { }
+
+  mmap_range& operator=(mmap_range&& x)
+  {
+    mmap_range tmp(std::move(x));
+    std::swap(ptr, tmp.ptr);
+    std::swap(len, tmp.len);
+    return *this;
+  }
+
+  ~mmap_range();
+
+  char const* data() const { return ptr; }
+  std::size_t size() const { return len; }
+  bool empty() const { return len == 0; }
+
+  char const* begin() const { return ptr; }
+  char const* end() const { return ptr + len; }
+
+  void advise(mmap_advice a) const;
+
+private:
+  char const* ptr = nullptr;
+  std::size_t len = 0;
+};
+
+namespace impl
+{
+
+[[noreturn]] inline void
+throw_errno(char const* what)
+{
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace impl
+
+inline
+mmap_range::mmap_range(char const* path, mmap_advice a)
+{
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    impl::throw_errno(path);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int e = errno;
+    ::close(fd);
+    errno = e;
+    impl::throw_errno(path);
+  }
+  if (st.st_size > 0) {
+    void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      int e = errno;
+      ::close(fd);
+      errno = e;
+      impl::throw_errno(path);
+    }
+    ptr = static_cast<char const*>(p);
+    len = st.st_size;
+  }
+
+  // The mapping holds its own reference to the file.
+  ::close(fd);
+  advise(a);
+}
+
+inline
+mmap_range::~mmap_range()
+{
+  if (ptr)
+    ::munmap(const_cast<char*>(ptr), len);
+}
+
+// Advice is a hint, so failures are ignored.
+inline void
+mmap_range::advise(mmap_advice a) const
+{
+  if (!ptr)
+    return;
+  int flag = MADV_NORMAL;
+  switch (a) {
+  case mmap_advice::normal: flag = MADV_NORMAL; break;
+  case mmap_advice::sequential: flag = MADV_SEQUENTIAL; break;
+  case mmap_advice::random: flag = MADV_RANDOM; break;
+  case mmap_advice::willneed: flag = MADV_WILLNEED; break;
+  }
+  ::madvise(const_cast<char*>(ptr), len, flag);
+}
+
+} // namespace stl
+
+#endif
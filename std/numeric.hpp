@@ -0,0 +1,590 @@
+
+#ifndef STL_NUMERIC_HPP
+#define STL_NUMERIC_HPP
+
+#include "algorithm.hpp"
+
+
+namespace stl
+{
+
+// Reduction and scan kernels
+//
+// A reduction may combine the elements in any order, so its operation
+// must be associative and commutative. Random access sequences are
+// reduced into reduce_accumulators independent accumulators, which
+// breaks the dependency between successive operations; for arithmetic
+// values, the compiler keeps the accumulators in vector registers.
+//
+// A scan is a chain of dependent operations, so it runs element by
+// element on each thread. In parallel, the sequence is split into
+// tiles. The first pass reduces every tile, the tile sums are scanned,
+// and the second pass scans every tile starting from the sum of the
+// tiles before it.
+//
+// The kernels work on g(i), the (transformed and projected) value of
+// the i-th element.
+
+namespace impl
+{
+
+constexpr std::ptrdiff_t reduce_accumulators = 8;
+
+// Reduces g(i) for i in [b, e) into init.
+template<typename T, typename Op, typename G>
+T
+reduce_index(std::ptrdiff_t b, std::ptrdiff_t e, T init, Op& op, G& g)
+{
+  constexpr std::ptrdiff_t k = reduce_accumulators;
+  if (e - b >= k) {
+    T acc[k] = {T(g(b)), T(g(b + 1)), T(g(b + 2)), T(g(b + 3)),
+                T(g(b + 4)), T(g(b + 5)), T(g(b + 6)), T(g(b + 7))};
+    for (b += k; e - b >= k; b += k)
+      for (std::ptrdiff_t j = 0; j < k; ++j)
+        acc[j] = stl::invoke(op, acc[j], g(b + j));
+    for (std::ptrdiff_t j = 0; j < k; ++j)
+      init = stl::invoke(op, init, acc[j]);
+  }
+  for (; b != e; ++b)
+    init = stl::invoke(op, init, g(b));
+  return init;
+}
+
+// Writes the scan of g(i) for i in [b, e), continuing from acc, to
+// out[i]. Returns the last value written. An element is read before its
+// output is written, so out may be the input.
+template<typename T, typename Op, typename G, typename O>
+T
+inclusive_scan_index(std::ptrdiff_t b, std::ptrdiff_t e, T acc, Op& op,
+                     G& g, O out)
+{
+  for (; b != e; ++b) {
+    acc = stl::invoke(op, acc, g(b));
+    out[b] = acc;
+  }
+  return acc;
+}
+
+// As above, except that out[i] does not include g(i). Returns the sum
+// of acc and all g(i).
+template<typename T, typename Op, typename G, typename O>
+T
+exclusive_scan_index(std::ptrdiff_t b, std::ptrdiff_t e, T acc, Op& op,
+                     G& g, O out)
+{
+  for (; b != e; ++b) {
+    T next = stl::invoke(op, acc, g(b));
+    out[b] = std::move(acc);
+    acc = std::move(next);
+  }
+  return acc;
+}
+
+
+// Returns the number of tiles to split n elements into, or 1 if they
+// should not be split.
+inline std::ptrdiff_t
+tile_count(thread_pool* pool, std::ptrdiff_t n)
+{
+  if (!pool)
+    return 1;
+  std::ptrdiff_t k = 4 * static_cast<std::ptrdiff_t>(pool->size());
+  if (k > n / parallel_grain)
+    k = n / parallel_grain;
+  return k > 1 ? k : 1;
+}
+
+// The first pass of a parallel scan. Stores the sum of g over the tiles
+// up to and including the i-th in sums[i].
+template<typename T, typename Op, typename G>
+void
+tile_sums(thread_pool& pool, std::ptrdiff_t n, std::vector<T>& sums,
+          Op& op, G& g)
+{
+  std::ptrdiff_t k = sums.size();
+  task_group group(pool);
+  for (std::ptrdiff_t i = 0; i < k; ++i)
+    impl::spawn(group, [&, i]() {
+      std::ptrdiff_t b = n * i / k;
+      std::ptrdiff_t e = n * (i + 1) / k;
+      sums[i] = impl::reduce_index(b + 1, e, T(g(b)), op, g);
+    });
+  group.wait();
+  for (std::ptrdiff_t i = 1; i < k; ++i)
+    sums[i] = stl::invoke(op, sums[i - 1], sums[i]);
+}
+
+
+template<typename T, typename Op, typename G>
+T
+par_reduce_index(thread_pool* pool, std::ptrdiff_t n, T init, Op& op, G& g)
+{
+  std::ptrdiff_t k = tile_count(pool, n);
+  if (k == 1)
+    return impl::reduce_index(0, n, std::move(init), op, g);
+  std::vector<T> part(k, init);
+  task_group group(*pool);
+  for (std::ptrdiff_t i = 0; i < k; ++i)
+    impl::spawn(group, [&, i]() {
+      std::ptrdiff_t b = n * i / k;
+      std::ptrdiff_t e = n * (i + 1) / k;
+      part[i] = impl::reduce_index(b + 1, e, T(g(b)), op, g);
+    });
+  group.wait();
+  for (T& x : part)
+    init = stl::invoke(op, init, x);
+  return init;
+}
+
+template<typename T, typename Op, typename G, typename O>
+void
+par_inclusive_scan_index(thread_pool* pool, std::ptrdiff_t n, Op& op,
+                         G& g, O out)
+{
+  if (n == 0)
+    return;
+  std::ptrdiff_t k = tile_count(pool, n);
+  if (k == 1) {
+    T acc = g(0);
+    out[0] = acc;
+    impl::inclusive_scan_index(1, n, std::move(acc), op, g, out);
+    return;
+  }
+  std::vector<T> sums(k, T(g(0)));
+  impl::tile_sums(*pool, n, sums, op, g);
+  auto tile = [&](std::ptrdiff_t i) {
+    std::ptrdiff_t b = n * i / k;
+    std::ptrdiff_t e = n * (i + 1) / k;
+    if (i == 0) {
+      T acc = g(0);
+      out[0] = acc;
+      impl::inclusive_scan_index(1, e, std::move(acc), op, g, out);
+    } else {
+      impl::inclusive_scan_index(b, e, sums[i - 1], op, g, out);
+    }
+  };
+  task_group group(*pool);
+  for (std::ptrdiff_t i = 0; i < k; ++i)
+    impl::spawn(group, [&tile, i]() { tile(i); });
+  group.wait();
+}
+
+template<typename T, typename Op, typename G, typename O>
+void
+par_exclusive_scan_index(thread_pool* pool, std::ptrdiff_t n, T init,
+                         Op& op, G& g, O out)
+{
+  std::ptrdiff_t k = tile_count(pool, n);
+  if (k == 1) {
+    impl::exclusive_scan_index(0, n, std::move(init), op, g, out);
+    return;
+  }
+  std::vector<T> sums(k, init);
+  impl::tile_sums(*pool, n, sums, op, g);
+  auto tile = [&](std::ptrdiff_t i) {
+    std::ptrdiff_t b = n * i / k;
+    std::ptrdiff_t e = n * (i + 1) / k;
+    T acc = i == 0 ? init : stl::invoke(op, init, sums[i - 1]);
+    impl::exclusive_scan_index(b, e, std::move(acc), op, g, out);
+  };
+  task_group group(*pool);
+  for (std::ptrdiff_t i = 0; i < k; ++i)
+    impl::spawn(group, [&tile, i]() { tile(i); });
+  group.wait();
+}
+
+
+// Sequence kernels. f computes the value of an element. Sequences
+// without random access are folded element by element.
+
+template<typename I, typename S, typename T, typename Op, typename F>
+T
+reduce(thread_pool*, I first, S last, T init, Op& op, F& f)
+{
+  for (; first != last; ++first)
+    init = stl::invoke(op, init, stl::invoke(f, *first));
+  return init;
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, typename T,
+         typename Op, typename F>
+T
+reduce(thread_pool* pool, I first, S last, T init, Op& op, F& f)
+{
+  auto g = [&f, first](std::ptrdiff_t i) { return stl::invoke(f, first[i]); };
+  return impl::par_reduce_index(pool, last - first, std::move(init), op, g);
+}
+
+
+// Segmented sequences are reduced a local range at a time. In parallel,
+// random access ones are split into tiles as any other.
+template<SegmentedIterator I, typename T, typename Op, typename F>
+T
+reduce(thread_pool* pool, I first, I last, T init, Op& op, F& f)
+{
+  if constexpr (RandomAccessIterator<I>()) {
+    if (pool) {
+      auto g = [&f, first](std::ptrdiff_t i) { return stl::invoke(f, first[i]); };
+      return impl::par_reduce_index(pool, last - first, std::move(init), op, g);
+    }
+  }
+  impl::for_each_segment(first, last, [&](auto l, auto m) {
+    init = impl::reduce(nullptr, l, m, std::move(init), op, f);
+  });
+  return init;
+}
+
+
+// f computes the value of a pair of elements.
+template<typename I1, typename S1, typename I2, typename T, typename Op,
+         typename F>
+T
+reduce(thread_pool*, I1 first1, S1 last1, I2 first2, T init, Op& op, F& f)
+{
+  for (; first1 != last1; ++first1, ++first2)
+    init = stl::invoke(op, init, stl::invoke(f, *first1, *first2));
+  return init;
+}
+
+template<RandomAccessIterator I1, SizedSentinel<I1> S1,
+         RandomAccessIterator I2, typename T, typename Op, typename F>
+T
+reduce(thread_pool* pool, I1 first1, S1 last1, I2 first2, T init, Op& op, F& f)
+{
+  auto g = [&f, first1, first2](std::ptrdiff_t i) {
+    return stl::invoke(f, first1[i], first2[i]);
+  };
+  return impl::par_reduce_index(pool, last1 - first1, std::move(init), op, g);
+}
+
+
+template<typename I, typename F>
+using scan_value_t = decay_t<invoke_result_t<F&, reference_t<I>>>;
+
+template<typename I, typename S, typename O, typename Op, typename F>
+std::pair<I, O>
+inclusive_scan(thread_pool*, I first, S last, O result, Op& op, F& f)
+{
+  if (first == last)
+    return {first, result};
+  scan_value_t<I, F> acc = stl::invoke(f, *first);
+  *result = acc;
+  for (++first, ++result; first != last; ++first, ++result) {
+    acc = stl::invoke(op, acc, stl::invoke(f, *first));
+    *result = acc;
+  }
+  return {first, result};
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, RandomAccessIterator O,
+         typename Op, typename F>
+std::pair<I, O>
+inclusive_scan(thread_pool* pool, I first, S last, O result, Op& op, F& f)
+{
+  difference_type_t<I> n = last - first;
+  auto g = [&f, first](std::ptrdiff_t i) { return stl::invoke(f, first[i]); };
+  impl::par_inclusive_scan_index<scan_value_t<I, F>>(pool, n, op, g, result);
+  return {first + n, result + n};
+}
+
+
+template<typename I, typename S, typename O, typename T, typename Op,
+         typename F>
+std::pair<I, O>
+exclusive_scan(thread_pool*, I first, S last, O result, T init, Op& op, F& f)
+{
+  for (; first != last; ++first, ++result) {
+    T next = stl::invoke(op, init, stl::invoke(f, *first));
+    *result = std::move(init);
+    init = std::move(next);
+  }
+  return {first, result};
+}
+
+template<RandomAccessIterator I, SizedSentinel<I> S, RandomAccessIterator O,
+         typename T, typename Op, typename F>
+std::pair<I, O>
+exclusive_scan(thread_pool* pool, I first, S last, O result, T init, Op& op,
+               F& f)
+{
+  difference_type_t<I> n = last - first;
+  auto g = [&f, first](std::ptrdiff_t i) { return stl::invoke(f, first[i]); };
+  impl::par_exclusive_scan_index(pool, n, std::move(init), op, g, result);
+  return {first + n, result + n};
+}
+
+} // namespace impl
+
+
+// Reduce
+//
+// Combines init and the (projected) elements in an unspecified order.
+
+template<InputIterator I, Sentinel<I> S, typename T, typename Op = plus<>,
+         typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<I, P>>()
+inline T
+reduce(I first, S last, T init, Op op = Op{}, P proj = P{})
+{
+  return impl::reduce(nullptr, first, last, std::move(init), op, proj);
+}
+
+template<InputRange R, typename T, typename Op = plus<>,
+         typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<iterator_t<R>, P>>()
+inline T
+reduce(R&& range, T init, Op op = Op{}, P proj = P{})
+{
+  return impl::reduce(nullptr, begin(range), end(range), std::move(init), op, proj);
+}
+
+
+// Transform reduce
+//
+// Reduces f applied to each (projected) element, or op2 applied to each
+// pair of (projected) elements of two sequences.
+
+template<InputIterator I, Sentinel<I> S, typename T, typename Op, typename F,
+         typename P = identity_fn>
+  requires RegularFunction<Op, T, T>() &&
+           IndirectRegularFunction<F, projected<I, P>>()
+inline T
+transform_reduce(I first, S last, T init, Op op, F f, P proj = P{})
+{
+  auto g = [&](auto&& x) { return stl::invoke(f, stl::invoke(proj, x)); };
+  return impl::reduce(nullptr, first, last, std::move(init), op, g);
+}
+
+template<InputRange R, typename T, typename Op, typename F,
+         typename P = identity_fn>
+  requires RegularFunction<Op, T, T>() &&
+           IndirectRegularFunction<F, projected<iterator_t<R>, P>>()
+inline T
+transform_reduce(R&& range, T init, Op op, F f, P proj = P{})
+{
+  auto g = [&](auto&& x) { return stl::invoke(f, stl::invoke(proj, x)); };
+  return impl::reduce(nullptr, begin(range), end(range), std::move(init), op, g);
+}
+
+template<InputIterator I1, Sentinel<I1> S1, InputIterator I2, typename T,
+         typename Op1 = plus<>, typename Op2 = multiplies<>,
+         typename P1 = identity_fn, typename P2 = identity_fn>
+  requires RegularFunction<Op1, T, T>() &&
+           IndirectRegularFunction<Op2, projected<I1, P1>, projected<I2, P2>>()
+inline T
+transform_reduce(I1 first1, S1 last1, I2 first2, T init, Op1 op1 = Op1{},
+                 Op2 op2 = Op2{}, P1 proj1 = P1{}, P2 proj2 = P2{})
+{
+  auto g = [&](auto&& x, auto&& y) {
+    return stl::invoke(op2, stl::invoke(proj1, x), stl::invoke(proj2, y));
+  };
+  return impl::reduce(nullptr, first1, last1, first2, std::move(init), op1, g);
+}
+
+template<InputRange R, InputIterator I, typename T,
+         typename Op1 = plus<>, typename Op2 = multiplies<>,
+         typename P1 = identity_fn, typename P2 = identity_fn>
+  requires RegularFunction<Op1, T, T>() &&
+           IndirectRegularFunction<Op2, projected<iterator_t<R>, P1>, projected<I, P2>>()
+inline T
+transform_reduce(R&& range, I first2, T init, Op1 op1 = Op1{},
+                 Op2 op2 = Op2{}, P1 proj1 = P1{}, P2 proj2 = P2{})
+{
+  auto g = [&](auto&& x, auto&& y) {
+    return stl::invoke(op2, stl::invoke(proj1, x), stl::invoke(proj2, y));
+  };
+  return impl::reduce(nullptr, begin(range), end(range), first2,
+                      std::move(init), op1, g);
+}
+
+
+// Inclusive scan
+//
+// Writes the running combination of the (projected) elements, the
+// i-th output including the i-th element. The output may be the input.
+
+template<InputIterator I, Sentinel<I> S, WeaklyIncrementable O,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, projected<I, P>, projected<I, P>>()
+inline std::pair<I, O>
+inclusive_scan(I first, S last, O result, Op op = Op{}, P proj = P{})
+{
+  return impl::inclusive_scan(nullptr, first, last, result, op, proj);
+}
+
+template<InputRange R, WeaklyIncrementable O, typename Op = plus<>,
+         typename P = identity_fn>
+  requires IndirectRegularFunction<Op, projected<iterator_t<R>, P>,
+                                       projected<iterator_t<R>, P>>()
+inline std::pair<iterator_t<R>, O>
+inclusive_scan(R&& range, O result, Op op = Op{}, P proj = P{})
+{
+  return impl::inclusive_scan(nullptr, begin(range), end(range), result, op, proj);
+}
+
+
+// Exclusive scan
+//
+// As above, starting from init, and the i-th output excluding the i-th
+// element.
+
+template<InputIterator I, Sentinel<I> S, WeaklyIncrementable O, typename T,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<I, P>>()
+inline std::pair<I, O>
+exclusive_scan(I first, S last, O result, T init, Op op = Op{}, P proj = P{})
+{
+  return impl::exclusive_scan(nullptr, first, last, result, std::move(init), op, proj);
+}
+
+template<InputRange R, WeaklyIncrementable O, typename T,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<iterator_t<R>, P>>()
+inline std::pair<iterator_t<R>, O>
+exclusive_scan(R&& range, O result, T init, Op op = Op{}, P proj = P{})
+{
+  return impl::exclusive_scan(nullptr, begin(range), end(range), result,
+                              std::move(init), op, proj);
+}
+
+
+// Reduce (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename T,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<I, P>>()
+inline T
+reduce(E&& policy, I first, S last, T init, Op op = Op{}, P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::reduce(pool, first, last, std::move(init), op, proj);
+}
+
+template<ExecutionPolicy E, InputRange R, typename T, typename Op = plus<>,
+         typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<iterator_t<R>, P>>()
+inline T
+reduce(E&& policy, R&& range, T init, Op op = Op{}, P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::reduce(pool, begin(range), end(range), std::move(init), op, proj);
+}
+
+
+// Transform reduce (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S, typename T,
+         typename Op, typename F, typename P = identity_fn>
+  requires RegularFunction<Op, T, T>() &&
+           IndirectRegularFunction<F, projected<I, P>>()
+inline T
+transform_reduce(E&& policy, I first, S last, T init, Op op, F f,
+                 P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  auto g = [&](auto&& x) { return stl::invoke(f, stl::invoke(proj, x)); };
+  return impl::reduce(pool, first, last, std::move(init), op, g);
+}
+
+template<ExecutionPolicy E, InputRange R, typename T, typename Op, typename F,
+         typename P = identity_fn>
+  requires RegularFunction<Op, T, T>() &&
+           IndirectRegularFunction<F, projected<iterator_t<R>, P>>()
+inline T
+transform_reduce(E&& policy, R&& range, T init, Op op, F f, P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  auto g = [&](auto&& x) { return stl::invoke(f, stl::invoke(proj, x)); };
+  return impl::reduce(pool, begin(range), end(range), std::move(init), op, g);
+}
+
+template<ExecutionPolicy E, InputIterator I1, Sentinel<I1> S1,
+         InputIterator I2, typename T,
+         typename Op1 = plus<>, typename Op2 = multiplies<>,
+         typename P1 = identity_fn, typename P2 = identity_fn>
+  requires RegularFunction<Op1, T, T>() &&
+           IndirectRegularFunction<Op2, projected<I1, P1>, projected<I2, P2>>()
+inline T
+transform_reduce(E&& policy, I1 first1, S1 last1, I2 first2, T init,
+                 Op1 op1 = Op1{}, Op2 op2 = Op2{},
+                 P1 proj1 = P1{}, P2 proj2 = P2{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  auto g = [&](auto&& x, auto&& y) {
+    return stl::invoke(op2, stl::invoke(proj1, x), stl::invoke(proj2, y));
+  };
+  return impl::reduce(pool, first1, last1, first2, std::move(init), op1, g);
+}
+
+template<ExecutionPolicy E, InputRange R, InputIterator I, typename T,
+         typename Op1 = plus<>, typename Op2 = multiplies<>,
+         typename P1 = identity_fn, typename P2 = identity_fn>
+  requires RegularFunction<Op1, T, T>() &&
+           IndirectRegularFunction<Op2, projected<iterator_t<R>, P1>, projected<I, P2>>()
+inline T
+transform_reduce(E&& policy, R&& range, I first2, T init, Op1 op1 = Op1{},
+                 Op2 op2 = Op2{}, P1 proj1 = P1{}, P2 proj2 = P2{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  auto g = [&](auto&& x, auto&& y) {
+    return stl::invoke(op2, stl::invoke(proj1, x), stl::invoke(proj2, y));
+  };
+  return impl::reduce(pool, begin(range), end(range), first2,
+                      std::move(init), op1, g);
+}
+
+
+// Inclusive scan (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S,
+         WeaklyIncrementable O, typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, projected<I, P>, projected<I, P>>()
+inline std::pair<I, O>
+inclusive_scan(E&& policy, I first, S last, O result, Op op = Op{},
+               P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::inclusive_scan(pool, first, last, result, op, proj);
+}
+
+template<ExecutionPolicy E, InputRange R, WeaklyIncrementable O,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, projected<iterator_t<R>, P>,
+                                       projected<iterator_t<R>, P>>()
+inline std::pair<iterator_t<R>, O>
+inclusive_scan(E&& policy, R&& range, O result, Op op = Op{}, P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::inclusive_scan(pool, begin(range), end(range), result, op, proj);
+}
+
+
+// Exclusive scan (parallel)
+
+template<ExecutionPolicy E, InputIterator I, Sentinel<I> S,
+         WeaklyIncrementable O, typename T, typename Op = plus<>,
+         typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<I, P>>()
+inline std::pair<I, O>
+exclusive_scan(E&& policy, I first, S last, O result, T init, Op op = Op{},
+               P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::exclusive_scan(pool, first, last, result, std::move(init), op, proj);
+}
+
+template<ExecutionPolicy E, InputRange R, WeaklyIncrementable O, typename T,
+         typename Op = plus<>, typename P = identity_fn>
+  requires IndirectRegularFunction<Op, T const*, projected<iterator_t<R>, P>>()
+inline std::pair<iterator_t<R>, O>
+exclusive_scan(E&& policy, R&& range, O result, T init, Op op = Op{},
+               P proj = P{})
+{
+  thread_pool* pool = impl::policy_pool(policy);
+  return impl::exclusive_scan(pool, begin(range), end(range), result,
+                              std::move(init), op, proj);
+}
+
+} // namespace stl
+
+#endif
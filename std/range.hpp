@@ -85,6 +85,16 @@ concept bool RandomAccessRange()
 }
 
 
+template<typename R>
+concept bool ContiguousRange()
+{
+  return SizedRange<R>() && ContiguousIterator<iterator_t<R>>() &&
+    requires (R& r) {
+      { data(r) } -> SameAs<remove_reference_t<reference_t<iterator_t<R>>>*>;
+    };
+}
+
+
 
 // Range access
 //
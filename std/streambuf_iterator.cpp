@@ -0,0 +1,2 @@
+
+#include "streambuf_iterator.hpp"
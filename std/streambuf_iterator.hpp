@@ -0,0 +1,163 @@
+
+#ifndef STL_STREAMBUF_ITERATOR_HPP
+#define STL_STREAMBUF_ITERATOR_HPP
+
+#include "iterator.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <streambuf>
+
+
+namespace stl
+{
+
+// Stream buffer iterators
+//
+// An istreambuf_iterator reads characters from a stream buffer. It is at
+// the end when the buffer has no more characters, so an input range of a
+// stream is [i, default_sentinel). A default constructed iterator is at
+// the end. Incrementing the iterator consumes the character, so copies
+// of an iterator share a position.
+
+template<typename C, typename T = std::char_traits<C>>
+class istreambuf_iterator
+{
+public:
+  using value_type        = C;
+  using reference         = C;
+  using difference_type   = typename T::off_type;
+  using iterator_category = input_iterator_tag;
+  using char_type         = C;
+  using traits_type       = T;
+  using streambuf_type    = std::basic_streambuf<C, T>;
+  using istream_type      = std::basic_istream<C, T>;
+
+  // The result of i++, which holds the character read.
+  class proxy
+  {
+  public:
+    using value_type = C;
+
+    proxy() = default;
+    explicit proxy(C c) : ch(c) { }
+
+    C const& operator*() const { return ch; }
+
+  private:
+    C ch = C();
+  };
+
+  istreambuf_iterator() = default;
+  istreambuf_iterator(default_sentinel) { }
+  istreambuf_iterator(istream_type& s) : sbuf(s.rdbuf()) { }
+  istreambuf_iterator(streambuf_type* s) : sbuf(s) { }
+
+  streambuf_type* rdbuf() const { return sbuf; }
+
+  C operator*() const { return T::to_char_type(sbuf->sgetc()); }
+
+  istreambuf_iterator& operator++()
+  {
+    sbuf->sbumpc();
+    return *this;
+  }
+
+  proxy operator++(int) { return proxy(T::to_char_type(sbuf->sbumpc())); }
+
+  bool at_end() const
+  {
+    return !sbuf || T::eq_int_type(sbuf->sgetc(), T::eof());
+  }
+
+private:
+  streambuf_type* sbuf = nullptr;
+};
+
+// Two iterators are equal when both or neither are at the end.
+template<typename C, typename T>
+inline bool
+operator==(istreambuf_iterator<C, T> const& a, istreambuf_iterator<C, T> const& b)
+{
+  return a.at_end() == b.at_end();
+}
+
+template<typename C, typename T>
+inline bool
+operator!=(istreambuf_iterator<C, T> const& a, istreambuf_iterator<C, T> const& b)
+{
+  return !(a == b);
+}
+
+template<typename C, typename T>
+inline bool
+operator==(istreambuf_iterator<C, T> const& i, default_sentinel)
+{
+  return i.at_end();
+}
+
+template<typename C, typename T>
+inline bool
+operator==(default_sentinel, istreambuf_iterator<C, T> const& i)
+{
+  return i.at_end();
+}
+
+template<typename C, typename T>
+inline bool
+operator!=(istreambuf_iterator<C, T> const& i, default_sentinel)
+{
+  return !i.at_end();
+}
+
+template<typename C, typename T>
+inline bool
+operator!=(default_sentinel, istreambuf_iterator<C, T> const& i)
+{
+  return !i.at_end();
+}
+
+
+// An ostreambuf_iterator writes characters to a stream buffer. Once a
+// write fails, the iterator discards the characters assigned to it and
+// failed() is true.
+
+template<typename C, typename T = std::char_traits<C>>
+class ostreambuf_iterator
+{
+public:
+  using value_type        = void;
+  using reference         = void;
+  using pointer           = void;
+  using difference_type   = std::ptrdiff_t;
+  using iterator_category = output_iterator_tag;
+  using char_type         = C;
+  using traits_type       = T;
+  using streambuf_type    = std::basic_streambuf<C, T>;
+  using ostream_type      = std::basic_ostream<C, T>;
+
+  ostreambuf_iterator() = default;
+  ostreambuf_iterator(ostream_type& s) : sbuf(s.rdbuf()) { }
+  ostreambuf_iterator(streambuf_type* s) : sbuf(s) { }
+
+  ostreambuf_iterator& operator=(C c)
+  {
+    if (!failed() && T::eq_int_type(sbuf->sputc(c), T::eof()))
+      sbuf = nullptr;
+    return *this;
+  }
+
+  ostreambuf_iterator& operator*() { return *this; }
+  ostreambuf_iterator& operator++() { return *this; }
+  ostreambuf_iterator& operator++(int) { return *this; }
+
+  bool failed() const { return !sbuf; }
+
+private:
+  streambuf_type* sbuf = nullptr;
+};
+
+
+} // namespace stl
+
+#endif
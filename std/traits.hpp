@@ -12,6 +12,9 @@ namespace stl
 template<bool B>
 using boolean_constant = std::integral_constant<bool, B>;
 
+using true_type = boolean_constant<true>;
+using false_type = boolean_constant<false>;
+
 
 template<typename T>
 concept bool is_void_v = std::is_void<T>::value;
@@ -45,6 +48,10 @@ template<typename T>
 constexpr bool is_variable_v = is_reference_v<T> || is_object_v<T>;
 
 
+template<typename T>
+constexpr bool is_arithmetic_v = std::is_arithmetic<T>::value;
+
+
 template<typename T>
 constexpr bool is_signed_v = std::is_signed<T>::value;
 
@@ -65,6 +72,18 @@ template<typename T>
 constexpr bool is_nothrow_move_assignable_v = std::is_nothrow_move_assignable<T>::value;
 
 
+template<typename T>
+constexpr bool is_trivially_copyable_v = std::is_trivially_copyable<T>::value;
+
+
+// A type is trivially relocatable when moving an object to new storage
+// and destroying the original is the same as copying its bytes. Trivially
+// copyable types are; others that are, such as a type that owns a
+// pointer, may specialize this.
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_copyable_v<T>;
+
+
 template<typename T, typename U>
 constexpr bool is_convertible_v = std::is_convertible<T, U>::value;
 
@@ -81,10 +100,159 @@ template<typename T>
 using decay_t = typename std::decay<T>::type;
 
 
+template<typename T>
+using make_unsigned_t = typename std::make_unsigned<T>::type;
+
+
 template<typename T>
 using result_of_t = typename std::result_of<T>::type;
 
 
+// Invoke
+//
+// invoke(f, args...) calls f with args. When f is a pointer to a member
+// function, the first argument is the object (a reference, a
+// reference_wrapper, or a pointer) and the rest are the arguments of the
+// call; when f is a pointer to a data member, the only argument is the
+// object and the result is a reference to its member. Otherwise, it calls
+// f(args...).
+//
+// The result is returned exactly as the call returns it, so a member
+// projection such as &record::key yields a reference into the record: it
+// compiles to a field load, and nothing is copied.
+
+namespace impl
+{
+
+// A reference wrapper, such as std::reference_wrapper<T>, converts to and
+// gets a reference to its T. It is recognized by its interface, so that
+// this header does not need <functional>.
+template<typename T>
+struct is_reference_wrapper : false_type { };
+
+template<typename T>
+  requires std::is_class<T>::value
+        && std::is_same<decltype(std::declval<T const&>().get()), typename T::type&>::value
+        && std::is_convertible<T const&, typename T::type&>::value
+struct is_reference_wrapper<T> : true_type { };
+
+// Returns the object designated by the first argument of a call through a
+// pointer to a member of C.
+template<typename C, typename T>
+  requires std::is_base_of<C, decay_t<T>>::value
+constexpr T&&
+member_object(T&& t) noexcept
+{
+  return std::forward<T>(t);
+}
+
+// An object of class type C, or derived from it, is not unwrapped even if
+// it looks like a reference wrapper.
+template<typename C, typename T>
+  requires !std::is_base_of<C, decay_t<T>>::value
+        && is_reference_wrapper<decay_t<T>>::value
+constexpr typename decay_t<T>::type&
+member_object(T&& t) noexcept
+{
+  return t.get();
+}
+
+template<typename C, typename T>
+  requires !std::is_base_of<C, decay_t<T>>::value
+        && !is_reference_wrapper<decay_t<T>>::value
+constexpr auto
+member_object(T&& t) noexcept(noexcept(*std::forward<T>(t)))
+  -> decltype(*std::forward<T>(t))
+{
+  return *std::forward<T>(t);
+}
+
+template<typename C, typename T>
+using member_object_t = decltype(member_object<C>(std::declval<T>()));
+
+// The result of invoking an F, whose decayed type is D, with Args.
+template<typename D, typename F, typename... Args>
+struct invoke_traits
+{
+  using type = decltype(std::declval<F>()(std::declval<Args>()...));
+};
+
+template<typename M, typename C, typename F, typename T, typename... Args>
+  requires std::is_function<M>::value
+struct invoke_traits<M C::*, F, T, Args...>
+{
+  using type = decltype((std::declval<member_object_t<C, T>>().*std::declval<M C::*>())
+                        (std::declval<Args>()...));
+};
+
+template<typename M, typename C, typename F, typename T>
+  requires !std::is_function<M>::value
+struct invoke_traits<M C::*, F, T>
+{
+  using type = decltype(std::declval<member_object_t<C, T>>().*std::declval<M C::*>());
+};
+
+template<typename M, typename C, typename T, typename... Args>
+  requires std::is_function<M>::value
+constexpr decltype(auto)
+invoke_member(M C::* f, T&& t, Args&&... args)
+  noexcept(noexcept((member_object<C>(std::forward<T>(t)).*f)(std::forward<Args>(args)...)))
+{
+  return (member_object<C>(std::forward<T>(t)).*f)(std::forward<Args>(args)...);
+}
+
+template<typename M, typename C, typename T>
+  requires !std::is_function<M>::value
+constexpr decltype(auto)
+invoke_member(M C::* f, T&& t)
+  noexcept(noexcept(member_object<C>(std::forward<T>(t))))
+{
+  return member_object<C>(std::forward<T>(t)).*f;
+}
+
+template<typename F, typename... Args>
+constexpr bool
+nothrow_invoke()
+{
+  if constexpr (is_member_pointer_v<decay_t<F>>)
+    return noexcept(invoke_member(std::declval<decay_t<F>>(), std::declval<Args>()...));
+  else
+    return noexcept(std::declval<F>()(std::declval<Args>()...));
+}
+
+} // namespace impl
+
+
+template<typename F, typename... Args>
+struct invoke_result
+{ };
+
+template<typename F, typename... Args>
+  requires requires { typename impl::invoke_traits<decay_t<F>, F, Args...>::type; }
+struct invoke_result<F, Args...>
+{
+  using type = typename impl::invoke_traits<decay_t<F>, F, Args...>::type;
+};
+
+template<typename F, typename... Args>
+using invoke_result_t = typename invoke_result<F, Args...>::type;
+
+
+template<typename F, typename... Args>
+constexpr invoke_result_t<F, Args...>
+invoke(F&& f, Args&&... args) noexcept(impl::nothrow_invoke<F, Args...>())
+{
+  if constexpr (is_member_pointer_v<decay_t<F>>)
+    return impl::invoke_member(f, std::forward<Args>(args)...);
+  else
+    return std::forward<F>(f)(std::forward<Args>(args)...);
+}
+
+
+template<bool B, typename T, typename U>
+using conditional_t = typename std::conditional<B, T, U>::type;
+
+
 template<typename T, typename U>
 using common_type_t = typename std::common_type<T, U>::type;
 
@@ -0,0 +1,2 @@
+
+#include "view.hpp"
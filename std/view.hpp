@@ -0,0 +1,1873 @@
+
+#ifndef STL_VIEW_HPP
+#define STL_VIEW_HPP
+
+#include "range.hpp"
+#include "algorithm.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+
+namespace stl
+{
+
+// Views
+//
+// A view is a range that refers to elements it does not own, so copying
+// a view does not copy its elements. The view adaptors are lazy: they
+// compute their elements as they are traversed, and a pipeline of views
+// allocates nothing.
+//
+// An adaptor applies view::all to the range it adapts. An lvalue range
+// is referred to, and must outlive the view; a view is copied into the
+// adaptor. Adapting an rvalue container is an error, since the view would
+// outlive it.
+//
+// The adaptors can be called with a range, as in view::take(r, 10), or
+// without, as in view::take(10), and applied to a range with operator|.
+// Partial applications compose:
+//
+//    for (int x : v | view::filter(odd) | view::transform(square))
+//      ...
+//
+// An adaptor's iterators refer to the view that produced them, so they
+// are invalidated when the view is moved or destroyed.
+
+struct view_base { };
+
+template<typename T>
+concept bool View()
+{
+  return Range<T>() && MoveConstructible<T>() && DerivedFrom<T, view_base>();
+}
+
+
+namespace impl
+{
+
+template<bool Const, typename T>
+using maybe_const_t = conditional_t<Const, T const, T>;
+
+// The iterator category of an adaptor that can only go forward and
+// back, given that of the underlying iterator.
+template<typename I>
+using bidirectional_category_t =
+  conditional_t<DerivedFrom<iterator_category_t<I>, bidirectional_iterator_tag>(),
+                bidirectional_iterator_tag,
+                iterator_category_t<I>>;
+
+// The begin() of a view whose first element is found by a linear
+// search is computed once, so that calling begin() repeatedly takes
+// amortized constant time. A copy of the view starts over, since the
+// cached iterator may refer into the view it was copied from.
+template<typename I>
+class cached_position
+{
+public:
+  cached_position() = default;
+  cached_position(cached_position const&) : cached(false) { }
+  cached_position& operator=(cached_position const&)
+  {
+    cached = false;
+    return *this;
+  }
+
+  explicit operator bool() const { return cached; }
+  I get() const { return pos; }
+  void set(I i)
+  {
+    pos = i;
+    cached = true;
+  }
+
+private:
+  I pos;
+  bool cached = false;
+};
+
+} // namespace impl
+
+
+// Ref view
+//
+// A view of all the elements of an lvalue range.
+
+template<Range R>
+class ref_view : public view_base
+{
+public:
+  ref_view() = default;
+
+  explicit ref_view(R& r)
+    : rng(&r)
+  { }
+
+  R& base() const { return *rng; }
+
+  iterator_t<R> begin() const { return stl::begin(*rng); }
+  sentinel_t<R> end() const { return stl::end(*rng); }
+
+  auto size() const requires SizedRange<R>() { return stl::size(*rng); }
+
+private:
+  R* rng = nullptr;
+};
+
+
+// Subrange
+//
+// A view of the elements of an iterator and a sentinel. It is sized
+// when the sentinel is. When the iterator is contiguous, data() is the
+// address of the first element, so algorithms searching the subrange
+// run over pointers.
+
+template<Iterator I, Sentinel<I> S = I>
+class subrange : public view_base
+{
+public:
+  subrange() = default;
+
+  subrange(I i, S s)
+    : first(i), last(s)
+  { }
+
+  I begin() const { return first; }
+  S end() const { return last; }
+
+  bool empty() const { return first == last; }
+
+  difference_type_t<I> size() const requires SizedSentinel<S, I>()
+  {
+    return last - first;
+  }
+
+  remove_reference_t<reference_t<I>>* data() const
+    requires ContiguousIterator<I>() && SizedSentinel<S, I>()
+  {
+    return first == last ? nullptr : std::addressof(*first);
+  }
+
+private:
+  I first;
+  S last;
+};
+
+
+namespace view
+{
+
+struct all_fn
+{
+  template<typename V>
+    requires View<decay_t<V>>()
+  decay_t<V> operator()(V&& v) const
+  {
+    return std::forward<V>(v);
+  }
+
+  template<typename R>
+    requires Range<R>() && !View<decay_t<R>>() && is_lvalue_reference_v<R>
+  ref_view<remove_reference_t<R>> operator()(R&& r) const
+  {
+    return ref_view<remove_reference_t<R>>(r);
+  }
+};
+
+constexpr all_fn all { };
+
+} // namespace view
+
+template<typename R>
+using all_t = decltype(view::all(std::declval<R>()));
+
+template<typename R>
+concept bool ViewableRange()
+{
+  return Range<R>() && requires { typename all_t<R>; };
+}
+
+
+namespace impl
+{
+
+// A partially applied adaptor. Applying it to a range r, as in r | c,
+// calls c.fn(r). Composing two closures, as in c | d, gives a closure
+// that applies c and then d.
+template<typename F>
+struct view_closure
+{
+  template<typename R>
+  auto operator()(R&& r) const { return fn(std::forward<R>(r)); }
+
+  F fn;
+};
+
+template<typename F>
+inline view_closure<F>
+make_view_closure(F fn)
+{
+  return {std::move(fn)};
+}
+
+template<ViewableRange R, typename F>
+inline auto
+operator|(R&& r, view_closure<F> const& c)
+{
+  return c.fn(std::forward<R>(r));
+}
+
+template<typename F, typename G>
+inline auto
+operator|(view_closure<F> c, view_closure<G> d)
+{
+  return make_view_closure([c, d](auto&& r) {
+    return d.fn(c.fn(std::forward<decltype(r)>(r)));
+  });
+}
+
+} // namespace impl
+
+
+// Transform view
+//
+// The elements of a range with a function applied to them. The function
+// is called every time an iterator is dereferenced, so it should be
+// cheap, and may be called more than once for each element.
+
+template<InputRange V, CopyConstructible F>
+  requires View<V>() && IndirectRegularFunction<F, iterator_t<V>>()
+class transform_view : public view_base
+{
+  template<bool Const> class iterator;
+  template<bool Const> class sentinel;
+
+public:
+  transform_view(V base, F f)
+    : rng(std::move(base)), fun(std::move(f))
+  { }
+
+  V base() const { return rng; }
+
+  iterator<false> begin() { return {stl::begin(rng), fun}; }
+  iterator<true> begin() const
+    requires Range<V const>()
+  { return {stl::begin(rng), fun}; }
+
+  sentinel<false> end() { return sentinel<false>(stl::end(rng)); }
+  iterator<false> end()
+    requires BoundedRange<V>()
+  { return {stl::end(rng), fun}; }
+
+  sentinel<true> end() const
+    requires Range<V const>()
+  { return sentinel<true>(stl::end(rng)); }
+  iterator<true> end() const
+    requires BoundedRange<V const>()
+  { return {stl::end(rng), fun}; }
+
+  auto size() const requires SizedRange<V>() { return stl::size(rng); }
+
+private:
+  V rng;
+  F fun;
+};
+
+template<InputRange V, CopyConstructible F>
+  requires View<V>() && IndirectRegularFunction<F, iterator_t<V>>()
+template<bool Const>
+class transform_view<V, F>::iterator
+{
+  using I = iterator_t<impl::maybe_const_t<Const, V>>;
+
+public:
+  using reference = invoke_result_t<F const&, reference_t<I>>;
+  using value_type = decay_t<reference>;
+  using difference_type = difference_type_t<I>;
+  using iterator_category = iterator_category_t<I>;
+
+  iterator() = default;
+
+  iterator(I i, F const& f)
+    : cur(i), fun(&f)
+  { }
+
+  I base() const { return cur; }
+
+  reference operator*() const { return stl::invoke(*fun, *cur); }
+
+  iterator& operator++() { ++cur; return *this; }
+  iterator operator++(int) { iterator tmp = *this; ++cur; return tmp; }
+
+  iterator& operator--() requires BidirectionalIterator<I>()
+  { --cur; return *this; }
+  iterator operator--(int) requires BidirectionalIterator<I>()
+  { iterator tmp = *this; --cur; return tmp; }
+
+  iterator& operator+=(difference_type n) requires RandomAccessIterator<I>()
+  { cur += n; return *this; }
+  iterator& operator-=(difference_type n) requires RandomAccessIterator<I>()
+  { cur -= n; return *this; }
+
+  iterator operator+(difference_type n) const requires RandomAccessIterator<I>()
+  { return {cur + n, *fun}; }
+  iterator operator-(difference_type n) const requires RandomAccessIterator<I>()
+  { return {cur - n, *fun}; }
+  difference_type operator-(iterator const& i) const
+    requires RandomAccessIterator<I>()
+  { return cur - i.cur; }
+
+  reference operator[](difference_type n) const requires RandomAccessIterator<I>()
+  { return stl::invoke(*fun, cur[n]); }
+
+  friend iterator operator+(difference_type n, iterator const& i)
+  { return i + n; }
+
+  bool operator==(iterator const& i) const { return cur == i.cur; }
+  bool operator!=(iterator const& i) const { return cur != i.cur; }
+
+  bool operator<(iterator const& i) const requires RandomAccessIterator<I>()
+  { return cur < i.cur; }
+  bool operator>(iterator const& i) const requires RandomAccessIterator<I>()
+  { return cur > i.cur; }
+  bool operator<=(iterator const& i) const requires RandomAccessIterator<I>()
+  { return cur <= i.cur; }
+  bool operator>=(iterator const& i) const requires RandomAccessIterator<I>()
+  { return cur >= i.cur; }
+
+private:
+  I cur;
+  F const* fun = nullptr;
+};
+
+template<InputRange V, CopyConstructible F>
+  requires View<V>() && IndirectRegularFunction<F, iterator_t<V>>()
+template<bool Const>
+class transform_view<V, F>::sentinel
+{
+  using S = sentinel_t<impl::maybe_const_t<Const, V>>;
+
+public:
+  sentinel() = default;
+
+  explicit sentinel(S s)
+    : last(s)
+  { }
+
+  S base() const { return last; }
+
+  friend bool operator==(iterator<Const> const& i, sentinel const& s)
+  { return i.base() == s.last; }
+  friend bool operator==(sentinel const& s, iterator<Const> const& i)
+  { return i.base() == s.last; }
+  friend bool operator!=(iterator<Const> const& i, sentinel const& s)
+  { return i.base() != s.last; }
+  friend bool operator!=(sentinel const& s, iterator<Const> const& i)
+  { return i.base() != s.last; }
+
+private:
+  S last;
+};
+
+
+// Filter view
+//
+// The elements of a range that satisfy a predicate. Incrementing an
+// iterator searches for the next such element. The search for the first
+// one is done by the first call to begin().
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class filter_view : public view_base
+{
+  class iterator;
+  class sentinel;
+
+public:
+  filter_view(V base, P p)
+    : rng(std::move(base)), pred(std::move(p))
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin();
+
+  sentinel end() { return sentinel(stl::end(rng)); }
+  iterator end() requires BoundedRange<V>() { return {stl::end(rng), *this}; }
+
+private:
+  V rng;
+  P pred;
+  impl::cached_position<iterator_t<V>> first;
+};
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class filter_view<V, P>::iterator
+{
+  using I = iterator_t<V>;
+
+public:
+  using reference = reference_t<I>;
+  using value_type = value_type_t<I>;
+  using difference_type = difference_type_t<I>;
+  using iterator_category = impl::bidirectional_category_t<I>;
+
+  iterator() = default;
+
+  iterator(I i, filter_view& v)
+    : cur(i), parent(&v)
+  { }
+
+  I base() const { return cur; }
+
+  reference operator*() const { return *cur; }
+
+  iterator& operator++()
+  {
+    auto last = stl::end(parent->rng);
+    do
+      ++cur;
+    while (cur != last && !stl::invoke(parent->pred, *cur));
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  iterator& operator--() requires BidirectionalIterator<I>()
+  {
+    do
+      --cur;
+    while (!stl::invoke(parent->pred, *cur));
+    return *this;
+  }
+
+  iterator operator--(int) requires BidirectionalIterator<I>()
+  { iterator tmp = *this; --*this; return tmp; }
+
+  bool operator==(iterator const& i) const { return cur == i.cur; }
+  bool operator!=(iterator const& i) const { return cur != i.cur; }
+
+private:
+  I cur;
+  filter_view* parent = nullptr;
+};
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class filter_view<V, P>::sentinel
+{
+  using S = sentinel_t<V>;
+
+public:
+  sentinel() = default;
+
+  explicit sentinel(S s)
+    : last(s)
+  { }
+
+  S base() const { return last; }
+
+  friend bool operator==(iterator const& i, sentinel const& s)
+  { return i.base() == s.last; }
+  friend bool operator==(sentinel const& s, iterator const& i)
+  { return i.base() == s.last; }
+  friend bool operator!=(iterator const& i, sentinel const& s)
+  { return i.base() != s.last; }
+  friend bool operator!=(sentinel const& s, iterator const& i)
+  { return i.base() != s.last; }
+
+private:
+  S last;
+};
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+auto
+filter_view<V, P>::begin() -> iterator
+{
+  if (!first) {
+    auto i = stl::begin(rng);
+    auto last = stl::end(rng);
+    while (i != last && !stl::invoke(pred, *i))
+      ++i;
+    first.set(i);
+  }
+  return {first.get(), *this};
+}
+
+
+// Take view
+//
+// The first n elements of a range, or all of them if there are fewer.
+// When the range is random access and sized, the view is the subrange
+// [first, first + min(n, size)) of the underlying iterators. Otherwise,
+// its iterators are counted iterators.
+
+template<InputRange V>
+  requires View<V>()
+class take_view : public view_base
+{
+  using I = iterator_t<V>;
+  using D = difference_type_t<I>;
+
+  class sentinel;
+
+public:
+  take_view(V base, D n)
+    : rng(std::move(base)), count(n)
+  { }
+
+  V base() const { return rng; }
+
+  counted_iterator<I> begin()
+  {
+    return {stl::begin(rng), count};
+  }
+
+  counted_iterator<I> begin() requires SizedRange<V>()
+  {
+    return {stl::begin(rng), size()};
+  }
+
+  I begin() requires RandomAccessRange<V>() && SizedRange<V>()
+  {
+    return stl::begin(rng);
+  }
+
+  sentinel end() { return sentinel(stl::end(rng)); }
+  default_sentinel end() requires SizedRange<V>() { return {}; }
+
+  I end() requires RandomAccessRange<V>() && SizedRange<V>()
+  {
+    return stl::begin(rng) + size();
+  }
+
+  D size() const requires SizedRange<V>()
+  {
+    D n = stl::size(rng);
+    return n < count ? n : count;
+  }
+
+private:
+  V rng;
+  D count;
+};
+
+// The end of the first n elements of an unsized range: either the nth
+// element or the end of the range.
+template<InputRange V>
+  requires View<V>()
+class take_view<V>::sentinel
+{
+  using S = sentinel_t<V>;
+  using C = counted_iterator<I>;
+
+public:
+  sentinel() = default;
+
+  explicit sentinel(S s)
+    : last(s)
+  { }
+
+  S base() const { return last; }
+
+  friend bool operator==(C const& i, sentinel const& s)
+  { return i.count() == 0 || i.base() == s.last; }
+  friend bool operator==(sentinel const& s, C const& i)
+  { return i == s; }
+  friend bool operator!=(C const& i, sentinel const& s)
+  { return !(i == s); }
+  friend bool operator!=(sentinel const& s, C const& i)
+  { return !(i == s); }
+
+private:
+  S last;
+};
+
+
+// Drop view
+//
+// All but the first n elements of a range, or none of them if there are
+// fewer. Unless the range is random access and sized, the first call to
+// begin() advances past the dropped elements, and later calls reuse the
+// result.
+
+template<InputRange V>
+  requires View<V>()
+class drop_view : public view_base
+{
+  using I = iterator_t<V>;
+  using D = difference_type_t<I>;
+
+public:
+  drop_view(V base, D n)
+    : rng(std::move(base)), count(n)
+  { }
+
+  V base() const { return rng; }
+
+  I begin()
+  {
+    if (!first)
+      first.set(stl::next(stl::begin(rng), count, stl::end(rng)));
+    return first.get();
+  }
+
+  I begin() requires RandomAccessRange<V>() && SizedRange<V>()
+  {
+    D n = stl::size(rng);
+    return stl::begin(rng) + (n < count ? n : count);
+  }
+
+  sentinel_t<V> end() { return stl::end(rng); }
+
+  D size() const requires SizedRange<V>()
+  {
+    D n = stl::size(rng);
+    return n < count ? 0 : n - count;
+  }
+
+private:
+  V rng;
+  D count;
+  impl::cached_position<I> first;
+};
+
+
+// Take while view
+//
+// The elements of a range up to the first one that does not satisfy a
+// predicate.
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class take_while_view : public view_base
+{
+  class sentinel;
+
+public:
+  take_while_view(V base, P p)
+    : rng(std::move(base)), pred(std::move(p))
+  { }
+
+  V base() const { return rng; }
+
+  iterator_t<V> begin() { return stl::begin(rng); }
+  sentinel end() { return sentinel(stl::end(rng), pred); }
+
+private:
+  V rng;
+  P pred;
+};
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class take_while_view<V, P>::sentinel
+{
+  using I = iterator_t<V>;
+  using S = sentinel_t<V>;
+
+public:
+  sentinel() = default;
+
+  sentinel(S s, P const& p)
+    : last(s), pred(&p)
+  { }
+
+  S base() const { return last; }
+
+  friend bool operator==(I const& i, sentinel const& s)
+  { return i == s.last || !stl::invoke(*s.pred, *i); }
+  friend bool operator==(sentinel const& s, I const& i)
+  { return i == s; }
+  friend bool operator!=(I const& i, sentinel const& s)
+  { return !(i == s); }
+  friend bool operator!=(sentinel const& s, I const& i)
+  { return !(i == s); }
+
+private:
+  S last;
+  P const* pred = nullptr;
+};
+
+
+// Drop while view
+//
+// The elements of a range from the first one that does not satisfy a
+// predicate. The search for that element is done by the first call to
+// begin().
+
+template<InputRange V, CopyConstructible P>
+  requires View<V>() && IndirectPredicate<P, iterator_t<V>>()
+class drop_while_view : public view_base
+{
+public:
+  drop_while_view(V base, P p)
+    : rng(std::move(base)), pred(std::move(p))
+  { }
+
+  V base() const { return rng; }
+
+  iterator_t<V> begin()
+  {
+    if (!first) {
+      auto i = stl::begin(rng);
+      auto last = stl::end(rng);
+      while (i != last && stl::invoke(pred, *i))
+        ++i;
+      first.set(i);
+    }
+    return first.get();
+  }
+
+  sentinel_t<V> end() { return stl::end(rng); }
+
+private:
+  V rng;
+  P pred;
+  impl::cached_position<iterator_t<V>> first;
+};
+
+
+// Bounded view
+//
+// A range whose iterator and sentinel have the same type, so that it can
+// be passed to algorithms (including those of the standard library) that
+// require one. Its iterators are common iterators. view::bounded of a
+// range that is already bounded is view::all of it.
+
+template<InputRange V>
+  requires View<V>() && !BoundedRange<V>()
+class bounded_view : public view_base
+{
+  using I = common_iterator<iterator_t<V>, sentinel_t<V>>;
+
+public:
+  explicit bounded_view(V base)
+    : rng(std::move(base))
+  { }
+
+  V base() const { return rng; }
+
+  I begin() { return I(stl::begin(rng)); }
+  I end() { return I(stl::end(rng)); }
+
+  auto size() const requires SizedRange<V>() { return stl::size(rng); }
+
+private:
+  V rng;
+};
+
+
+// Join view
+//
+// The elements of the inner ranges of a range of ranges, in order. The
+// inner ranges are referred to, so the outer range must yield lvalue
+// references to them. Incrementing an iterator steps through an inner
+// range and skips over empty ones.
+//
+// The iterators are segmented when the outer range is a forward range:
+// its segments are the inner ranges, so the segment-aware algorithms
+// (find, find_if, all_of, any_of, none_of, copy and reduce) run a loop
+// over each inner range in turn.
+
+template<InputRange V>
+  requires View<V>() && is_lvalue_reference_v<reference_t<iterator_t<V>>> &&
+           InputRange<reference_t<iterator_t<V>>>()
+class join_view : public view_base
+{
+  using O = iterator_t<V>;
+  using R = remove_reference_t<reference_t<O>>;
+  using I = iterator_t<R>;
+
+  class iterator;
+
+public:
+  explicit join_view(V base)
+    : rng(std::move(base))
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin() { return iterator(stl::begin(rng), *this); }
+
+  default_sentinel end() { return {}; }
+  iterator end() requires BoundedRange<V>()
+  { return iterator(stl::end(rng), *this); }
+
+private:
+  V rng;
+};
+
+template<InputRange V>
+  requires View<V>() && is_lvalue_reference_v<reference_t<iterator_t<V>>> &&
+           InputRange<reference_t<iterator_t<V>>>()
+class join_view<V>::iterator
+{
+public:
+  using reference = reference_t<I>;
+  using value_type = value_type_t<I>;
+  using difference_type =
+    std::common_type_t<difference_type_t<O>, difference_type_t<I>>;
+  using iterator_category =
+    conditional_t<ForwardIterator<O>() && ForwardIterator<I>(),
+                  forward_iterator_tag,
+                  input_iterator_tag>;
+
+  struct segment_traits;
+
+  iterator() = default;
+
+  iterator(O o, join_view& v)
+    : out(o), parent(&v)
+  { satisfy(); }
+
+  reference operator*() const { return *in; }
+
+  iterator& operator++()
+  {
+    if (++in == stl::end(*out)) {
+      ++out;
+      satisfy();
+    }
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  // The inner iterators of two iterators past the end are not compared.
+  friend bool operator==(iterator const& a, iterator const& b)
+  { return a.out == b.out && (a.at_end() || a.in == b.in); }
+  friend bool operator!=(iterator const& a, iterator const& b)
+  { return !(a == b); }
+
+  friend bool operator==(iterator const& i, default_sentinel) { return i.at_end(); }
+  friend bool operator==(default_sentinel, iterator const& i) { return i.at_end(); }
+  friend bool operator!=(iterator const& i, default_sentinel) { return !i.at_end(); }
+  friend bool operator!=(default_sentinel, iterator const& i) { return !i.at_end(); }
+
+private:
+  bool at_end() const { return out == stl::end(parent->rng); }
+
+  // Moves to the first element of the first non-empty inner range,
+  // starting with the current one.
+  void satisfy()
+  {
+    for (auto last = stl::end(parent->rng); out != last; ++out) {
+      in = stl::begin(*out);
+      if (in != stl::end(*out))
+        return;
+    }
+    in = I();
+  }
+
+  O out;
+  I in;
+  join_view* parent = nullptr;
+};
+
+template<InputRange V>
+  requires View<V>() && is_lvalue_reference_v<reference_t<iterator_t<V>>> &&
+           InputRange<reference_t<iterator_t<V>>>()
+struct join_view<V>::iterator::segment_traits
+{
+  static constexpr bool is_segmented = ForwardIterator<O>();
+
+  using segment_iterator = O;
+  using local_iterator = I;
+
+  static O segment(iterator const& i) { return i.out; }
+  static I local(iterator const& i) { return i.in; }
+
+  static I begin(O s) { return stl::begin(*s); }
+  static auto end(O s) { return stl::end(*s); }
+
+  static iterator compose(iterator i, O s, I l)
+  {
+    i.out = s;
+    i.in = l;
+    return i;
+  }
+
+  static bool has_segment(iterator const& i) { return !i.at_end(); }
+};
+
+
+// Split view
+//
+// The fields of a range separated by a delimiter, as subranges of the
+// underlying iterators, so no element is copied. The fields of a
+// contiguous range are contiguous, and their data() and size() can
+// make a string_view. Delimiters are found with find, which searches
+// contiguous ranges of integers a vector at a time.
+//
+// A range ending in a delimiter has an empty last field, unless the
+// view drops it, as view::lines does. An empty range has no fields.
+
+template<ForwardRange V>
+  requires View<V>() &&
+           IndirectRelation<equal_to<>, iterator_t<V>, value_type_t<iterator_t<V>> const*>()
+class split_view : public view_base
+{
+  using I = iterator_t<V>;
+  using T = value_type_t<I>;
+
+  class iterator;
+
+public:
+  split_view(V base, T d, bool keep_last = true)
+    : rng(std::move(base)), delim(std::move(d)), trailing(keep_last)
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin() { return iterator(*this); }
+  default_sentinel end() { return {}; }
+
+private:
+  V rng;
+  T delim;
+  bool trailing;
+};
+
+template<ForwardRange V>
+  requires View<V>() &&
+           IndirectRelation<equal_to<>, iterator_t<V>, value_type_t<iterator_t<V>> const*>()
+class split_view<V>::iterator
+{
+public:
+  using reference = subrange<I>;
+  using value_type = subrange<I>;
+  using difference_type = difference_type_t<I>;
+  using iterator_category = forward_iterator_tag;
+
+  iterator() = default;
+
+  explicit iterator(split_view& v)
+    : cur(stl::begin(v.rng)), parent(&v)
+  {
+    auto last = stl::end(v.rng);
+    done = cur == last;
+    if (!done)
+      stop = impl::find(cur, last, v.delim);
+  }
+
+  reference operator*() const { return {cur, stop}; }
+
+  // The field after a delimiter starts past it.
+  iterator& operator++()
+  {
+    auto last = stl::end(parent->rng);
+    if (stop == last) {
+      done = true;
+      return *this;
+    }
+    cur = stl::next(stop);
+    if (cur == last && !parent->trailing)
+      done = true;
+    else
+      stop = impl::find(cur, last, parent->delim);
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  bool operator==(iterator const& i) const
+  { return done == i.done && (done || cur == i.cur); }
+  bool operator!=(iterator const& i) const { return !(*this == i); }
+
+  friend bool operator==(iterator const& i, default_sentinel) { return i.done; }
+  friend bool operator==(default_sentinel, iterator const& i) { return i.done; }
+  friend bool operator!=(iterator const& i, default_sentinel) { return !i.done; }
+  friend bool operator!=(default_sentinel, iterator const& i) { return !i.done; }
+
+private:
+  I cur;
+  I stop;
+  split_view* parent = nullptr;
+  bool done = true;
+};
+
+
+// Zip reference
+//
+// The reference type of zip and enumerate: a tuple of the references of
+// the underlying iterators. Assigning to it assigns through to the
+// elements, and swapping two of them swaps the elements, so algorithms
+// that permute a zipped range permute all of its ranges together.
+// Converting it to its value type, a tuple of values, copies the
+// elements, even through std::move. To move them, iter_move on a zip
+// iterator returns a zip reference of rvalue references, which the
+// algorithms use to move elements in and out.
+//
+// It is a std::tuple, so std::get, comparisons and structured bindings
+// work as they do for tuples.
+
+template<typename... Rs>
+class zip_reference : public std::tuple<Rs...>
+{
+  using base = std::tuple<Rs...>;
+
+public:
+  using base::base;
+  using base::operator=;
+
+  friend void swap(zip_reference a, zip_reference b)
+  {
+    a.swap_elements(b, std::index_sequence_for<Rs...>{});
+  }
+
+private:
+  template<std::size_t... K>
+  void swap_elements(zip_reference& b, std::index_sequence<K...>)
+  {
+    using std::swap;
+    (swap(std::get<K>(*this), std::get<K>(b)), ...);
+  }
+};
+
+
+// Zip view
+//
+// The tuples of corresponding elements of several ranges, as long as the
+// shortest. An iterator holds an iterator into each range and advances
+// them together, so two iterators are compared by their first
+// components only. When the ranges are random access and sized, the end
+// of the view is an iterator, and a loop over it compares one iterator
+// per step, as an index loop does.
+
+template<InputRange... Vs>
+  requires (View<Vs>() && ...)
+class zip_view : public view_base
+{
+  class iterator;
+  class sentinel;
+
+  static constexpr bool sized = (SizedRange<Vs>() && ...);
+  static constexpr bool random = (RandomAccessRange<Vs>() && ...);
+
+public:
+  explicit zip_view(Vs... bases)
+    : rngs(std::move(bases)...)
+  { }
+
+  iterator begin()
+  {
+    return std::apply([](auto&... r) { return iterator(stl::begin(r)...); }, rngs);
+  }
+
+  sentinel end()
+  {
+    return std::apply([](auto&... r) { return sentinel(stl::end(r)...); }, rngs);
+  }
+
+  iterator end() requires sized && random { return begin() + size(); }
+
+  auto size() const requires sized
+  {
+    return std::apply([](auto const&... r) {
+      return std::min({std::common_type_t<decltype(stl::size(r))...>(stl::size(r))...});
+    }, rngs);
+  }
+
+private:
+  std::tuple<Vs...> rngs;
+};
+
+template<InputRange... Vs>
+  requires (View<Vs>() && ...)
+class zip_view<Vs...>::iterator
+{
+  static constexpr bool bidi = (BidirectionalIterator<iterator_t<Vs>>() && ...);
+
+public:
+  using reference = zip_reference<reference_t<iterator_t<Vs>>...>;
+  using rvalue_reference = zip_reference<rvalue_reference_t<iterator_t<Vs>>...>;
+  using value_type = std::tuple<value_type_t<iterator_t<Vs>>...>;
+  using difference_type = std::common_type_t<difference_type_t<iterator_t<Vs>>...>;
+  using iterator_category = std::common_type_t<iterator_category_t<iterator_t<Vs>>...>;
+
+  iterator() = default;
+
+  explicit iterator(iterator_t<Vs>... is)
+    : its(is...)
+  { }
+
+  std::tuple<iterator_t<Vs>...> base() const { return its; }
+
+  reference operator*() const
+  {
+    return std::apply([](auto const&... i) { return reference(*i...); }, its);
+  }
+
+  friend rvalue_reference iter_move(iterator const& i)
+  {
+    return std::apply([](auto const&... j) {
+      return rvalue_reference(iter_move(j)...);
+    }, i.its);
+  }
+
+  iterator& operator++()
+  {
+    std::apply([](auto&... i) { (++i, ...); }, its);
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  iterator& operator--() requires bidi
+  {
+    std::apply([](auto&... i) { (--i, ...); }, its);
+    return *this;
+  }
+
+  iterator operator--(int) requires bidi
+  { iterator tmp = *this; --*this; return tmp; }
+
+  iterator& operator+=(difference_type n) requires random
+  {
+    std::apply([n](auto&... i) { ((i += n), ...); }, its);
+    return *this;
+  }
+
+  iterator& operator-=(difference_type n) requires random
+  { return *this += -n; }
+
+  reference operator[](difference_type n) const requires random
+  { return *(*this + n); }
+
+  friend iterator operator+(iterator i, difference_type n) requires random
+  { return i += n; }
+  friend iterator operator+(difference_type n, iterator i) requires random
+  { return i += n; }
+  friend iterator operator-(iterator i, difference_type n) requires random
+  { return i -= n; }
+  friend difference_type operator-(iterator const& a, iterator const& b) requires random
+  { return std::get<0>(a.its) - std::get<0>(b.its); }
+
+  friend bool operator==(iterator const& a, iterator const& b)
+  { return std::get<0>(a.its) == std::get<0>(b.its); }
+  friend bool operator!=(iterator const& a, iterator const& b)
+  { return !(a == b); }
+
+  friend bool operator<(iterator const& a, iterator const& b) requires random
+  { return std::get<0>(a.its) < std::get<0>(b.its); }
+  friend bool operator>(iterator const& a, iterator const& b) requires random
+  { return b < a; }
+  friend bool operator<=(iterator const& a, iterator const& b) requires random
+  { return !(b < a); }
+  friend bool operator>=(iterator const& a, iterator const& b) requires random
+  { return !(a < b); }
+
+private:
+  friend class sentinel;
+
+  std::tuple<iterator_t<Vs>...> its;
+};
+
+// The end of the shortest range: an iterator is at the end when any of
+// its components is.
+template<InputRange... Vs>
+  requires (View<Vs>() && ...)
+class zip_view<Vs...>::sentinel
+{
+public:
+  sentinel() = default;
+
+  explicit sentinel(sentinel_t<Vs>... ss)
+    : lasts(ss...)
+  { }
+
+  friend bool operator==(iterator const& i, sentinel const& s)
+  { return s.reached(i, std::index_sequence_for<Vs...>{}); }
+  friend bool operator==(sentinel const& s, iterator const& i)
+  { return i == s; }
+  friend bool operator!=(iterator const& i, sentinel const& s)
+  { return !(i == s); }
+  friend bool operator!=(sentinel const& s, iterator const& i)
+  { return !(i == s); }
+
+private:
+  template<std::size_t... K>
+  bool reached(iterator const& i, std::index_sequence<K...>) const
+  {
+    return ((std::get<K>(i.its) == std::get<K>(lasts)) || ...);
+  }
+
+  std::tuple<sentinel_t<Vs>...> lasts;
+};
+
+
+// Enumerate view
+//
+// The elements of a range paired with their positions, counting from 0.
+// Its references are zip references, as in:
+//
+//    for (auto [i, x] : v | view::enumerate)
+//      ...
+
+template<InputRange V>
+  requires View<V>()
+class enumerate_view : public view_base
+{
+  using I = iterator_t<V>;
+  using D = difference_type_t<I>;
+
+  class iterator;
+  class sentinel;
+
+public:
+  explicit enumerate_view(V base)
+    : rng(std::move(base))
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin() { return {0, stl::begin(rng)}; }
+
+  sentinel end() { return sentinel(stl::end(rng)); }
+  iterator end() requires BoundedRange<V>() && SizedRange<V>()
+  { return {size(), stl::end(rng)}; }
+
+  D size() const requires SizedRange<V>() { return stl::size(rng); }
+
+private:
+  V rng;
+};
+
+template<InputRange V>
+  requires View<V>()
+class enumerate_view<V>::iterator
+{
+public:
+  using reference = zip_reference<D, reference_t<I>>;
+  using rvalue_reference = zip_reference<D, rvalue_reference_t<I>>;
+  using value_type = std::tuple<D, value_type_t<I>>;
+  using difference_type = D;
+  using iterator_category = iterator_category_t<I>;
+
+  iterator() = default;
+
+  iterator(D n, I i)
+    : pos(n), cur(i)
+  { }
+
+  I base() const { return cur; }
+  D index() const { return pos; }
+
+  reference operator*() const { return reference(pos, *cur); }
+
+  friend rvalue_reference iter_move(iterator const& i)
+  { return rvalue_reference(i.pos, iter_move(i.cur)); }
+
+  iterator& operator++() { ++pos; ++cur; return *this; }
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  iterator& operator--() requires BidirectionalIterator<I>()
+  { --pos; --cur; return *this; }
+  iterator operator--(int) requires BidirectionalIterator<I>()
+  { iterator tmp = *this; --*this; return tmp; }
+
+  iterator& operator+=(D n) requires RandomAccessIterator<I>()
+  { pos += n; cur += n; return *this; }
+  iterator& operator-=(D n) requires RandomAccessIterator<I>()
+  { pos -= n; cur -= n; return *this; }
+
+  reference operator[](D n) const requires RandomAccessIterator<I>()
+  { return reference(pos + n, cur[n]); }
+
+  friend iterator operator+(iterator i, D n) requires RandomAccessIterator<I>()
+  { return i += n; }
+  friend iterator operator+(D n, iterator i) requires RandomAccessIterator<I>()
+  { return i += n; }
+  friend iterator operator-(iterator i, D n) requires RandomAccessIterator<I>()
+  { return i -= n; }
+  friend D operator-(iterator const& a, iterator const& b) requires RandomAccessIterator<I>()
+  { return a.cur - b.cur; }
+
+  friend bool operator==(iterator const& a, iterator const& b) { return a.cur == b.cur; }
+  friend bool operator!=(iterator const& a, iterator const& b) { return a.cur != b.cur; }
+
+  friend bool operator<(iterator const& a, iterator const& b) requires RandomAccessIterator<I>()
+  { return a.cur < b.cur; }
+  friend bool operator>(iterator const& a, iterator const& b) requires RandomAccessIterator<I>()
+  { return a.cur > b.cur; }
+  friend bool operator<=(iterator const& a, iterator const& b) requires RandomAccessIterator<I>()
+  { return a.cur <= b.cur; }
+  friend bool operator>=(iterator const& a, iterator const& b) requires RandomAccessIterator<I>()
+  { return a.cur >= b.cur; }
+
+private:
+  D pos = 0;
+  I cur;
+};
+
+template<InputRange V>
+  requires View<V>()
+class enumerate_view<V>::sentinel
+{
+  using S = sentinel_t<V>;
+
+public:
+  sentinel() = default;
+
+  explicit sentinel(S s)
+    : last(s)
+  { }
+
+  S base() const { return last; }
+
+  friend bool operator==(iterator const& i, sentinel const& s)
+  { return i.base() == s.last; }
+  friend bool operator==(sentinel const& s, iterator const& i)
+  { return i.base() == s.last; }
+  friend bool operator!=(iterator const& i, sentinel const& s)
+  { return i.base() != s.last; }
+  friend bool operator!=(sentinel const& s, iterator const& i)
+  { return i.base() != s.last; }
+
+private:
+  S last;
+};
+
+
+namespace impl
+{
+
+// The iterator of a chunk or stride view of a random access, sized
+// range. It holds the index of a chunk (or element) of the view, at
+// offset index * step into the range, so every operation is constant
+// time and the last chunk is clamped to the end of the range.
+template<RandomAccessIterator I, bool Chunk>
+class step_iterator
+{
+  using D = difference_type_t<I>;
+
+public:
+  using reference = conditional_t<Chunk, subrange<I>, reference_t<I>>;
+  using value_type = conditional_t<Chunk, subrange<I>, value_type_t<I>>;
+  using difference_type = D;
+  using iterator_category = random_access_iterator_tag;
+
+  step_iterator() = default;
+
+  step_iterator(I i, D k, D n, D len)
+    : first(i), pos(k), step(n), length(len)
+  { }
+
+  D index() const { return pos; }
+
+  reference operator*() const { return (*this)[0]; }
+
+  reference operator[](D k) const
+  {
+    D b = (pos + k) * step;
+    if constexpr (Chunk)
+      return {first + b, first + (length - b < step ? length : b + step)};
+    else
+      return first[b];
+  }
+
+  step_iterator& operator++() { ++pos; return *this; }
+  step_iterator operator++(int) { step_iterator tmp = *this; ++pos; return tmp; }
+  step_iterator& operator--() { --pos; return *this; }
+  step_iterator operator--(int) { step_iterator tmp = *this; --pos; return tmp; }
+
+  step_iterator& operator+=(D k) { pos += k; return *this; }
+  step_iterator& operator-=(D k) { pos -= k; return *this; }
+
+  friend step_iterator operator+(step_iterator i, D k) { return i += k; }
+  friend step_iterator operator+(D k, step_iterator i) { return i += k; }
+  friend step_iterator operator-(step_iterator i, D k) { return i -= k; }
+  friend D operator-(step_iterator const& a, step_iterator const& b)
+  { return a.pos - b.pos; }
+
+  friend bool operator==(step_iterator const& a, step_iterator const& b)
+  { return a.pos == b.pos; }
+  friend bool operator!=(step_iterator const& a, step_iterator const& b)
+  { return a.pos != b.pos; }
+  friend bool operator<(step_iterator const& a, step_iterator const& b)
+  { return a.pos < b.pos; }
+  friend bool operator>(step_iterator const& a, step_iterator const& b)
+  { return a.pos > b.pos; }
+  friend bool operator<=(step_iterator const& a, step_iterator const& b)
+  { return a.pos <= b.pos; }
+  friend bool operator>=(step_iterator const& a, step_iterator const& b)
+  { return a.pos >= b.pos; }
+
+private:
+  I first;
+  D pos = 0;
+  D step = 1;
+  D length = 0;
+};
+
+// The number of steps of n elements needed to cover len elements.
+template<typename D>
+inline D
+steps(D len, D n)
+{
+  return len / n + (len % n != 0);
+}
+
+} // namespace impl
+
+
+// Chunk view
+//
+// The consecutive subranges of n elements of a range, the last of which
+// may be shorter. When the range is random access and sized, the view
+// is too, and its iterators compute the bounds of a chunk from its
+// index. Otherwise, incrementing an iterator advances the end of the
+// chunk by n, bounded by the end of the range, which takes constant
+// time when the range's sentinel is sized.
+
+template<ForwardRange V>
+  requires View<V>()
+class chunk_view : public view_base
+{
+  using I = iterator_t<V>;
+  using D = difference_type_t<I>;
+  using J = impl::step_iterator<I, true>;
+
+  class iterator;
+
+public:
+  chunk_view(V base, D n)
+    : rng(std::move(base)), count(n)
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin() { return iterator(stl::begin(rng), *this); }
+  J begin() requires RandomAccessRange<V>() && SizedRange<V>()
+  { return J(stl::begin(rng), 0, count, stl::size(rng)); }
+
+  default_sentinel end() { return {}; }
+  J end() requires RandomAccessRange<V>() && SizedRange<V>()
+  { return J(stl::begin(rng), size(), count, stl::size(rng)); }
+
+  D size() const requires SizedRange<V>()
+  { return impl::steps<D>(stl::size(rng), count); }
+
+private:
+  V rng;
+  D count;
+};
+
+template<ForwardRange V>
+  requires View<V>()
+class chunk_view<V>::iterator
+{
+public:
+  using reference = subrange<I>;
+  using value_type = subrange<I>;
+  using difference_type = D;
+  using iterator_category = forward_iterator_tag;
+
+  iterator() = default;
+
+  iterator(I i, chunk_view& v)
+    : cur(i), stop(stl::next(i, v.count, stl::end(v.rng))), parent(&v)
+  { }
+
+  reference operator*() const { return {cur, stop}; }
+
+  iterator& operator++()
+  {
+    cur = stop;
+    stl::advance(stop, parent->count, stl::end(parent->rng));
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  bool operator==(iterator const& i) const { return cur == i.cur; }
+  bool operator!=(iterator const& i) const { return cur != i.cur; }
+
+  friend bool operator==(iterator const& i, default_sentinel) { return i.at_end(); }
+  friend bool operator==(default_sentinel, iterator const& i) { return i.at_end(); }
+  friend bool operator!=(iterator const& i, default_sentinel) { return !i.at_end(); }
+  friend bool operator!=(default_sentinel, iterator const& i) { return !i.at_end(); }
+
+private:
+  bool at_end() const { return cur == stl::end(parent->rng); }
+
+  I cur;
+  I stop;
+  chunk_view* parent = nullptr;
+};
+
+
+// Stride view
+//
+// Every kth element of a range, starting with the first. As with chunk,
+// a random access, sized range gives a random access, sized view, and
+// otherwise an increment advances by k, bounded by the end of the range.
+
+template<ForwardRange V>
+  requires View<V>()
+class stride_view : public view_base
+{
+  using I = iterator_t<V>;
+  using D = difference_type_t<I>;
+  using J = impl::step_iterator<I, false>;
+
+  class iterator;
+
+public:
+  stride_view(V base, D k)
+    : rng(std::move(base)), step(k)
+  { }
+
+  V base() const { return rng; }
+
+  iterator begin() { return iterator(stl::begin(rng), *this); }
+  J begin() requires RandomAccessRange<V>() && SizedRange<V>()
+  { return J(stl::begin(rng), 0, step, stl::size(rng)); }
+
+  default_sentinel end() { return {}; }
+  J end() requires RandomAccessRange<V>() && SizedRange<V>()
+  { return J(stl::begin(rng), size(), step, stl::size(rng)); }
+
+  D size() const requires SizedRange<V>()
+  { return impl::steps<D>(stl::size(rng), step); }
+
+private:
+  V rng;
+  D step;
+};
+
+template<ForwardRange V>
+  requires View<V>()
+class stride_view<V>::iterator
+{
+public:
+  using reference = reference_t<I>;
+  using value_type = value_type_t<I>;
+  using difference_type = D;
+  using iterator_category = forward_iterator_tag;
+
+  iterator() = default;
+
+  iterator(I i, stride_view& v)
+    : cur(i), parent(&v)
+  { }
+
+  I base() const { return cur; }
+
+  reference operator*() const { return *cur; }
+
+  iterator& operator++()
+  {
+    stl::advance(cur, parent->step, stl::end(parent->rng));
+    return *this;
+  }
+
+  iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+  bool operator==(iterator const& i) const { return cur == i.cur; }
+  bool operator!=(iterator const& i) const { return cur != i.cur; }
+
+  friend bool operator==(iterator const& i, default_sentinel) { return i.at_end(); }
+  friend bool operator==(default_sentinel, iterator const& i) { return i.at_end(); }
+  friend bool operator!=(iterator const& i, default_sentinel) { return !i.at_end(); }
+  friend bool operator!=(default_sentinel, iterator const& i) { return !i.at_end(); }
+
+private:
+  bool at_end() const { return cur == stl::end(parent->rng); }
+
+  I cur;
+  stride_view* parent = nullptr;
+};
+
+
+// Adaptors
+
+namespace view
+{
+
+struct bounded_fn
+{
+  template<InputRange R>
+    requires ViewableRange<R>() && BoundedRange<R>()
+  all_t<R> operator()(R&& r) const
+  {
+    return view::all(std::forward<R>(r));
+  }
+
+  template<InputRange R>
+    requires ViewableRange<R>() && !BoundedRange<R>()
+  bounded_view<all_t<R>> operator()(R&& r) const
+  {
+    return bounded_view<all_t<R>>(view::all(std::forward<R>(r)));
+  }
+};
+
+
+struct transform_fn
+{
+  template<InputRange R, CopyConstructible F>
+    requires ViewableRange<R>() && IndirectRegularFunction<F, iterator_t<R>>()
+  transform_view<all_t<R>, F> operator()(R&& r, F f) const
+  {
+    return {view::all(std::forward<R>(r)), std::move(f)};
+  }
+
+  template<CopyConstructible F>
+  auto operator()(F f) const
+  {
+    return impl::make_view_closure([f](auto&& r) {
+      return transform_fn{}(std::forward<decltype(r)>(r), f);
+    });
+  }
+};
+
+struct filter_fn
+{
+  template<InputRange R, CopyConstructible P>
+    requires ViewableRange<R>() && IndirectPredicate<P, iterator_t<R>>()
+  filter_view<all_t<R>, P> operator()(R&& r, P p) const
+  {
+    return {view::all(std::forward<R>(r)), std::move(p)};
+  }
+
+  template<CopyConstructible P>
+  auto operator()(P p) const
+  {
+    return impl::make_view_closure([p](auto&& r) {
+      return filter_fn{}(std::forward<decltype(r)>(r), p);
+    });
+  }
+};
+
+struct take_fn
+{
+  template<InputRange R>
+    requires ViewableRange<R>()
+  take_view<all_t<R>> operator()(R&& r, difference_type_t<iterator_t<R>> n) const
+  {
+    return {view::all(std::forward<R>(r)), n};
+  }
+
+  auto operator()(std::ptrdiff_t n) const
+  {
+    return impl::make_view_closure([n](auto&& r) {
+      return take_fn{}(std::forward<decltype(r)>(r), n);
+    });
+  }
+};
+
+struct drop_fn
+{
+  template<InputRange R>
+    requires ViewableRange<R>()
+  drop_view<all_t<R>> operator()(R&& r, difference_type_t<iterator_t<R>> n) const
+  {
+    return {view::all(std::forward<R>(r)), n};
+  }
+
+  auto operator()(std::ptrdiff_t n) const
+  {
+    return impl::make_view_closure([n](auto&& r) {
+      return drop_fn{}(std::forward<decltype(r)>(r), n);
+    });
+  }
+};
+
+struct take_while_fn
+{
+  template<InputRange R, CopyConstructible P>
+    requires ViewableRange<R>() && IndirectPredicate<P, iterator_t<R>>()
+  take_while_view<all_t<R>, P> operator()(R&& r, P p) const
+  {
+    return {view::all(std::forward<R>(r)), std::move(p)};
+  }
+
+  template<CopyConstructible P>
+  auto operator()(P p) const
+  {
+    return impl::make_view_closure([p](auto&& r) {
+      return take_while_fn{}(std::forward<decltype(r)>(r), p);
+    });
+  }
+};
+
+struct drop_while_fn
+{
+  template<InputRange R, CopyConstructible P>
+    requires ViewableRange<R>() && IndirectPredicate<P, iterator_t<R>>()
+  drop_while_view<all_t<R>, P> operator()(R&& r, P p) const
+  {
+    return {view::all(std::forward<R>(r)), std::move(p)};
+  }
+
+  template<CopyConstructible P>
+  auto operator()(P p) const
+  {
+    return impl::make_view_closure([p](auto&& r) {
+      return drop_while_fn{}(std::forward<decltype(r)>(r), p);
+    });
+  }
+};
+
+// The n elements starting at an iterator. When the iterator is random
+// access this is the subrange [i, i + n) of the iterator itself, so the
+// count is not kept alongside it. Otherwise, its iterators are counted
+// iterators.
+struct counted_fn
+{
+  template<Iterator I>
+  subrange<counted_iterator<I>, default_sentinel>
+  operator()(I i, difference_type_t<I> n) const
+  {
+    return {counted_iterator<I>(i, n), default_sentinel{}};
+  }
+
+  template<RandomAccessIterator I>
+  subrange<I> operator()(I i, difference_type_t<I> n) const
+  {
+    return {i, i + n};
+  }
+};
+
+struct join_fn
+{
+  template<InputRange R>
+    requires ViewableRange<R>() && is_lvalue_reference_v<reference_t<iterator_t<R>>> &&
+             InputRange<reference_t<iterator_t<R>>>()
+  join_view<all_t<R>> operator()(R&& r) const
+  {
+    return join_view<all_t<R>>(view::all(std::forward<R>(r)));
+  }
+};
+
+struct split_fn
+{
+  template<ForwardRange R>
+    requires ViewableRange<R>()
+  split_view<all_t<R>>
+  operator()(R&& r, value_type_t<iterator_t<R>> d) const
+  {
+    return {view::all(std::forward<R>(r)), std::move(d)};
+  }
+
+  template<typename T>
+  auto operator()(T d) const
+  {
+    return impl::make_view_closure([d](auto&& r) {
+      return split_fn{}(std::forward<decltype(r)>(r), d);
+    });
+  }
+};
+
+// The lines of a range of characters. A newline ends a line, so a
+// final newline does not start an empty one.
+struct lines_fn
+{
+  template<ForwardRange R>
+    requires ViewableRange<R>()
+  split_view<all_t<R>> operator()(R&& r) const
+  {
+    return {view::all(std::forward<R>(r)), '\n', false};
+  }
+};
+
+struct chunk_fn
+{
+  template<ForwardRange R>
+    requires ViewableRange<R>()
+  chunk_view<all_t<R>> operator()(R&& r, difference_type_t<iterator_t<R>> n) const
+  {
+    return {view::all(std::forward<R>(r)), n};
+  }
+
+  auto operator()(std::ptrdiff_t n) const
+  {
+    return impl::make_view_closure([n](auto&& r) {
+      return chunk_fn{}(std::forward<decltype(r)>(r), n);
+    });
+  }
+};
+
+struct stride_fn
+{
+  template<ForwardRange R>
+    requires ViewableRange<R>()
+  stride_view<all_t<R>> operator()(R&& r, difference_type_t<iterator_t<R>> k) const
+  {
+    return {view::all(std::forward<R>(r)), k};
+  }
+
+  auto operator()(std::ptrdiff_t k) const
+  {
+    return impl::make_view_closure([k](auto&& r) {
+      return stride_fn{}(std::forward<decltype(r)>(r), k);
+    });
+  }
+};
+
+struct zip_fn
+{
+  template<InputRange... Rs>
+    requires (ViewableRange<Rs>() && ...)
+  zip_view<all_t<Rs>...> operator()(Rs&&... rs) const
+  {
+    return zip_view<all_t<Rs>...>(view::all(std::forward<Rs>(rs))...);
+  }
+};
+
+struct enumerate_fn
+{
+  template<InputRange R>
+    requires ViewableRange<R>()
+  enumerate_view<all_t<R>> operator()(R&& r) const
+  {
+    return enumerate_view<all_t<R>>(view::all(std::forward<R>(r)));
+  }
+};
+
+constexpr counted_fn counted { };
+constexpr transform_fn transform { };
+constexpr filter_fn filter { };
+constexpr take_fn take { };
+constexpr drop_fn drop { };
+constexpr take_while_fn take_while { };
+constexpr drop_while_fn drop_while { };
+constexpr split_fn split { };
+constexpr zip_fn zip { };
+constexpr chunk_fn chunk { };
+constexpr stride_fn stride { };
+
+// Bounded, lines, enumerate and join take no arguments, so they are also
+// closures, as in r | view::bounded.
+constexpr impl::view_closure<bounded_fn> bounded { };
+constexpr impl::view_closure<lines_fn> lines { };
+constexpr impl::view_closure<enumerate_fn> enumerate { };
+constexpr impl::view_closure<join_fn> join { };
+
+} // namespace view
+
+} // namespace stl
+
+
+// Zip references are tuples, for structured bindings.
+namespace std
+{
+
+template<typename... Rs>
+struct tuple_size<stl::zip_reference<Rs...>>
+  : tuple_size<tuple<Rs...>>
+{ };
+
+template<std::size_t N, typename... Rs>
+struct tuple_element<N, stl::zip_reference<Rs...>>
+  : tuple_element<N, tuple<Rs...>>
+{ };
+
+} // namespace std
+
+#endif
@@ -1,8 +1,11 @@
 
 #include <std/algorithm.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
 #include <forward_list>
+#include <limits>
 #include <list>
 #include <vector>
 #include <string>
@@ -15,8 +18,594 @@ bool
 is_odd(int n) { return n % 2; }
 
 
+struct pair
+{
+  int key;
+  char value;
+};
+
+int key(pair const& p) { return p.key; }
+
+
+void
+test_find()
+{
+  // Long enough to exercise the vector loops and the scalar tail.
+  std::vector<int> v1(1000);
+  for (int i = 0; i < 1000; ++i)
+    v1[i] = i;
+  assert(stl::find(v1, 0) == v1.begin());
+  assert(stl::find(v1, 517) == v1.begin() + 517);
+  assert(stl::find(v1, 999) == v1.begin() + 999);
+  assert(stl::find(v1, 1000) == v1.end());
+  assert(stl::find(v1.data(), v1.data() + 1000, 517) == v1.data() + 517);
+  assert(stl::find(v1.data(), v1.data() + 1000, 517.5) == v1.data() + 1000);
+
+  std::string s1(300, 'a');
+  s1[257] = 'b';
+  assert(stl::find(s1, 'b') == s1.begin() + 257);
+  assert(stl::find(s1, 'b' + 256) == s1.end());
+
+  std::vector<long long> v2(100, -1);
+  v2[70] = 1ll << 40;
+  assert(stl::find(v2, 1ll << 40) == v2.begin() + 70);
+  assert(stl::find(v2, 1ll << 41) == v2.end());
+
+  std::list<int> l1 {1, 2, 3};
+  assert(stl::find(l1, 2) == ++l1.begin());
+  assert(stl::find(l1, 4) == l1.end());
+
+  std::vector<pair> v3 {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  assert(stl::find(v3, 2, key) == v3.begin() + 1);
+  assert(stl::find(v3, 4, key) == v3.end());
+}
+
+
+void
+test_find_if()
+{
+  std::vector<int> v1(1000, 1);
+  v1[600] = -1;
+  assert(stl::find_if_not(v1, is_pos) == v1.begin() + 600);
+  assert(stl::find_if(v1, is_odd) == v1.begin());
+  assert(stl::find_if(v1.begin(), v1.end(), is_pos) == v1.begin());
+
+  std::forward_list<int> f1 {2, 4, 5};
+  assert(stl::find_if(f1, is_odd) == std::next(f1.begin(), 2));
+  assert(stl::find_if_not(f1, is_pos) == f1.end());
+
+  std::vector<pair> v2 {{2, 'a'}, {4, 'b'}, {5, 'c'}};
+  assert(stl::find_if(v2, is_odd, key) == v2.begin() + 2);
+  assert(stl::find_if_not(v2, is_pos, key) == v2.end());
+
+  // The predicate is applied at most once per element.
+  std::vector<char> v3(1000, 0);
+  v3[700] = 1;
+  std::vector<int> calls(1000);
+  auto counted = [&](char const& c) {
+    ++calls[&c - v3.data()];
+    return c != 0;
+  };
+  assert(stl::find_if(v3, counted) == v3.begin() + 700);
+  assert(stl::all_of(calls, [](int n) { return n <= 1; }));
+  assert(calls[700] == 1);
+}
+
+
+void
+test_any_none()
+{
+  std::vector<int> v1(100, 2);
+  assert(!stl::any_of(v1, is_odd));
+  assert(stl::none_of(v1, is_odd));
+  v1[99] = 3;
+  assert(stl::any_of(v1, is_odd));
+  assert(!stl::none_of(v1.begin(), v1.end(), is_odd));
+
+  assert(stl::any_of({1, 2, 3}, is_odd));
+  assert(stl::none_of({-1, -2, -3}, is_pos));
+
+  std::vector<pair> v2 {{2, 'a'}, {4, 'b'}};
+  assert(!stl::any_of(v2, is_odd, key));
+  assert(stl::none_of(v2, is_odd, key));
+}
+
+
+template<typename T>
+void
+check_unguarded()
+{
+  // Every alignment of the start and of the match.
+  std::vector<T> v(200, T(1));
+  for (int i = 0; i < 64; ++i)
+    for (int j = i; j < i + 70; ++j) {
+      v[j] = T(7);
+      assert(stl::find(v.data() + i, stl::unreachable_sentinel{}, 7) == v.data() + j);
+      v[j] = T(1);
+    }
+}
+
+void
+test_unguarded()
+{
+  check_unguarded<char>();
+  check_unguarded<short>();
+  check_unguarded<int>();
+  check_unguarded<long long>();
+
+  // Values past the match are never inspected.
+  char const* s1 = "hello, world";
+  assert(stl::find(s1, stl::unreachable_sentinel{}, '\0') == s1 + 12);
+  assert(stl::find(s1, stl::unreachable_sentinel{}, ',') == s1 + 5);
+
+  std::vector<int> v1 {1, 3, 5, 6, 7};
+  assert(stl::find(v1.begin(), stl::unreachable_sentinel{}, 6) == v1.begin() + 3);
+  assert(stl::find_if(v1.begin(), stl::unreachable_sentinel{}, is_pos) == v1.begin());
+  assert(stl::find_if_not(v1.begin(), stl::unreachable_sentinel{}, is_odd) == v1.begin() + 3);
+
+  std::list<int> l1 {1, 3, 4};
+  assert(stl::find(l1.begin(), stl::unreachable_sentinel{}, 4) == --l1.end());
+  assert(stl::find_if_not(l1.begin(), stl::unreachable_sentinel{}, is_odd) == --l1.end());
+
+  // Search, guarded and unguarded.
+  std::string s2 = "abababcab";
+  std::string p1 = "abc";
+  assert(stl::search(s2, p1) == s2.begin() + 4);
+  assert(stl::search(s2, std::string("abd")) == s2.end());
+  assert(stl::search(s2, std::string("cab")) == s2.begin() + 6);
+  assert(stl::search(s2, std::string("cabx")) == s2.end());
+  assert(stl::search(s2, std::string()) == s2.begin());
+  assert(stl::search(s2.begin(), stl::unreachable_sentinel{}, p1.begin(), p1.end()) == s2.begin() + 4);
+  std::forward_list<int> f1 {1, 2, 1, 2, 3};
+  std::list<int> l2 {2, 3};
+  assert(stl::search(f1, l2) == std::next(f1.begin(), 3));
+
+  // Guarded find restores the last element.
+  std::vector<int> v2 {4, 5, 6};
+  assert(stl::guarded_find(v2, 5) == v2.begin() + 1);
+  assert(stl::guarded_find(v2, 6) == v2.begin() + 2);
+  assert(stl::guarded_find(v2, 7) == v2.end());
+  assert(v2 == (std::vector<int> {4, 5, 6}));
+  std::list<std::string> l3 {"a", "b"};
+  assert(stl::guarded_find(l3, std::string("c")) == l3.end());
+  assert(l3.back() == "b");
+  std::vector<int> v3;
+  assert(stl::guarded_find(v3, 1) == v3.end());
+
+  // Values that do not survive the store do not stop the search.
+  std::vector<char> v4 {1, 2, 44};
+  assert(stl::guarded_find(v4, 300) == v4.end());
+  assert(v4.back() == 44);
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> v5 {1.0, nan, 2.0};
+  assert(stl::guarded_find(v5, nan) == v5.end());
+  assert(v5.back() == 2.0);
+}
+
+
+void
+test_segmented()
+{
+  // A deque spans many blocks, and pushing to the front leaves the first
+  // one partly used.
+  std::deque<int> d;
+  for (int i = 0; i < 1000; ++i)
+    d.push_back(i);
+  for (int i = 1; i <= 100; ++i)
+    d.push_front(-i);
+  for (int x : {-100, -1, 0, 1, 127, 128, 500, 899, 999}) {
+    auto i = stl::find(d, x);
+    assert(i != d.end() && *i == x && i - d.begin() == x + 100);
+    assert(stl::find_if(d.begin(), d.end(), [x](int y) { return y == x; }) == i);
+  }
+  assert(stl::find(d, 1000) == d.end());
+  assert(stl::find(d.begin() + 10, d.begin() + 20, 0) == d.begin() + 20);
+  assert(stl::find(d.begin() + 300, d.end(), 5) == d.end());
+  assert(stl::find(d.end(), d.end(), 5) == d.end());
+
+  assert(stl::all_of(d, [](int x) { return x < 1000; }));
+  assert(!stl::all_of(d, [](int x) { return x != 640; }));
+  assert(stl::none_of(d, [](int x) { return x > 999; }));
+
+  std::vector<int> v(d.size());
+  assert(stl::copy(d, v.begin()).second == v.end());
+  assert(std::equal(v.begin(), v.end(), d.begin()));
+  std::vector<int> w;
+  auto p = stl::copy(d.begin() + 50, d.end() - 50, std::back_inserter(w));
+  assert(p.first == d.end() - 50 && w.size() == d.size() - 100);
+  assert(w.front() == -50 && w.back() == 949);
+
+  std::deque<int> const& c = d;
+  assert(*stl::find(c.begin(), c.end(), 42) == 42);
+}
+
+
+void
+test_copy()
+{
+  std::vector<int> v1 {1, 2, 3, 4, 5};
+  std::vector<int> v2(5);
+  auto r1 = stl::copy(v1, v2.begin());
+  assert(r1.first == v1.end() && r1.second == v2.end());
+  assert(v1 == v2);
+
+  std::deque<int> d1(5);
+  auto r2 = stl::copy(v1.begin(), v1.end(), d1.begin());
+  assert(r2.second == d1.end());
+  assert(d1[4] == 5);
+
+  std::list<int> l1(3);
+  auto r3 = stl::copy_n(v1.begin(), 3, l1.begin());
+  assert(r3.first == v1.begin() + 3 && r3.second == l1.end());
+  assert(l1.back() == 3);
+
+  int a1[5] = {};
+  stl::copy_n(v1.data(), 5, a1);
+  assert(a1[0] == 1 && a1[4] == 5);
+  assert(stl::copy_n(a1, 0, v2.data()).second == v2.data());
+
+  std::vector<std::string> v3 {"a", "b", "c"};
+  std::vector<std::string> v4(3);
+  stl::copy(v3, v4.begin());
+  assert(v3 == v4);
+}
+
+
+void
+test_move()
+{
+  std::vector<int> v1 {1, 2, 3, 4, 5};
+  auto r1 = stl::move_backward(v1.begin(), v1.begin() + 3, v1.end());
+  assert(r1.first == v1.begin() + 3 && r1.second == v1.begin() + 2);
+  assert((v1 == std::vector<int> {1, 2, 1, 2, 3}));
+
+  auto r2 = stl::move(v1.begin() + 2, v1.end(), v1.begin());
+  assert(r2.second == v1.begin() + 3);
+  assert(v1[0] == 1 && v1[1] == 2 && v1[2] == 3);
+
+  std::list<std::string> l1 {"a", "b", "c"};
+  std::vector<std::string> v2(4);
+  auto r3 = stl::move_backward(l1, v2.end());
+  assert(r3.first == l1.end() && r3.second == v2.begin() + 1);
+  assert(v2[1] == "a" && v2[3] == "c");
+}
+
+
+void
+test_fill()
+{
+  std::vector<int> v1(100, 1);
+  assert(stl::fill(v1, 0) == v1.end());
+  assert(stl::find(v1, 1) == v1.end());
+  assert(stl::fill_n(v1.begin(), 50, 0x01020304) == v1.begin() + 50);
+  assert(v1[49] == 0x01020304 && v1[50] == 0);
+
+  std::string s1(10, 'a');
+  stl::fill(s1.begin() + 5, s1.end(), 'b');
+  assert(s1 == "aaaaabbbbb");
+
+  std::list<int> l1(3);
+  assert(stl::fill_n(l1.begin(), 3, 7) == l1.end());
+  assert(l1.front() == 7);
+}
+
+
+template<typename T, typename C = std::less<T>>
+bool
+is_sorted(std::vector<T> const& v, C comp = C())
+{
+  for (std::size_t i = 1; i < v.size(); ++i)
+    if (comp(v[i], v[i - 1]))
+      return false;
+  return true;
+}
+
+
+void
+test_sort()
+{
+  // Patterns that defeat naive quicksort, at sizes on both sides of the
+  // insertion sort and ninther thresholds.
+  for (int n : {0, 1, 2, 10, 100, 1000, 100000}) {
+    std::vector<int> v1(n);
+    unsigned x = 1;
+    for (int& e : v1)
+      e = (x = x * 1103515245 + 12345) >> 8;
+    std::vector<int> v2 = v1;
+    assert(stl::sort(v1) == v1.end());
+    assert(is_sorted(v1));
+    assert(stl::sort(v1) == v1.end());
+    assert(is_sorted(v1));
+    stl::sort(v1, stl::greater<>());
+    assert(is_sorted(v1, std::greater<int>()));
+
+    for (int i = 0; i < n; ++i)
+      v1[i] = i < n / 2 ? i : n - i;
+    stl::sort(v1.begin(), v1.end());
+    assert(is_sorted(v1));
+
+    for (int i = 0; i < n; ++i)
+      v1[i] = v2[i] % 4;
+    stl::sort(v1);
+    assert(is_sorted(v1));
+
+    std::vector<std::string> v3(n);
+    for (int i = 0; i < n; ++i)
+      v3[i] = std::to_string(v2[i] % 1000);
+    stl::sort(v3);
+    assert(is_sorted(v3));
+  }
+
+  std::vector<pair> v4 {{3, 'a'}, {1, 'b'}, {2, 'c'}};
+  stl::sort(v4, stl::less<>(), key);
+  assert(v4[0].value == 'b' && v4[1].value == 'c' && v4[2].value == 'a');
+
+  int a1[] {3, 1, 2};
+  assert(stl::sort(a1, a1 + 3) == a1 + 3);
+  assert(a1[0] == 1 && a1[2] == 3);
+}
+
+
+void
+test_stable_sort()
+{
+  // Sizes on both sides of the run length, and with a partial last run.
+  for (int n : {0, 1, 31, 32, 33, 1000, 100000}) {
+    std::vector<pair> v1(n);
+    unsigned x = 1;
+    for (int i = 0; i < n; ++i) {
+      v1[i].key = (x = x * 1103515245 + 12345) >> 24;
+      v1[i].value = i;
+    }
+    std::vector<pair> v2 = v1;
+    assert(stl::stable_sort(v1, stl::less<>(), key) == v1.end());
+    std::stable_sort(v2.begin(), v2.end(), [](pair const& a, pair const& b) {
+      return a.key < b.key;
+    });
+    for (int i = 0; i < n; ++i)
+      assert(v1[i].key == v2[i].key && v1[i].value == v2[i].value);
+
+    std::vector<std::string> v3(n);
+    for (int i = 0; i < n; ++i)
+      v3[i] = std::to_string(v2[i].value % 1000);
+    stl::stable_sort(v3.begin(), v3.end(), stl::greater<>());
+    assert(is_sorted(v3, std::greater<std::string>()));
+  }
+}
+
+
+void
+test_radix_sort()
+{
+  for (int n : {0, 1, 10, 63, 64, 1000, 100000}) {
+    std::vector<int> v1(n);
+    unsigned x = 1;
+    for (int& e : v1)
+      e = (x = x * 1103515245 + 12345) - (1u << 31);
+    std::vector<int> v2 = v1;
+    assert(stl::radix_sort(v1) == v1.end());
+    stl::sort(v2);
+    assert(v1 == v2);
+
+    // Keys that differ only in their low byte take one pass.
+    std::vector<unsigned long long> v3(n);
+    for (int i = 0; i < n; ++i)
+      v3[i] = (1ull << 40) | (v1[i] & 0xff);
+    stl::radix_sort(v3);
+    assert(is_sorted(v3));
+
+    std::vector<short> v4(n);
+    std::vector<short> b4(n);
+    for (int i = 0; i < n; ++i)
+      v4[i] = v1[i];
+    stl::radix_sort(v4, b4);
+    assert(is_sorted(v4));
+
+    // A buffer that is too small is not used.
+    for (int i = 0; i < n; ++i)
+      v4[i] = v1[i];
+    std::vector<short> b5(n / 2);
+    stl::radix_sort(v4, b5);
+    assert(is_sorted(v4));
+  }
+
+  // Sorting records by a key is stable.
+  std::vector<pair> v5;
+  for (int i = 0; i < 1000; ++i)
+    v5.push_back({(i * 7) % 10 - 5, static_cast<char>(i / 10)});
+  std::vector<pair> b5(v5.size());
+  stl::radix_sort(v5, b5, key);
+  for (std::size_t i = 1; i < v5.size(); ++i) {
+    assert(v5[i - 1].key <= v5[i].key);
+    if (v5[i - 1].key == v5[i].key)
+      assert(v5[i - 1].value <= v5[i].value);
+  }
+
+  std::vector<std::string> v6;
+  for (int i = 0; i < 100; ++i)
+    v6.push_back(std::to_string(99 - i));
+  stl::radix_sort(v6, [](std::string const& s) { return s.size(); });
+  assert(v6[0] == "9" && v6[10] == "99");
+}
+
+
+void
+test_binary_search()
+{
+  for (int n : {0, 1, 2, 3, 100, 1001}) {
+    std::vector<int> v1(n);
+    for (int i = 0; i < n; ++i)
+      v1[i] = i / 3;
+    std::list<int> l1(v1.begin(), v1.end());
+    for (int x = -1; x <= n / 3 + 1; ++x) {
+      auto lo = std::lower_bound(v1.begin(), v1.end(), x);
+      auto hi = std::upper_bound(v1.begin(), v1.end(), x);
+      assert(stl::lower_bound(v1, x) == lo);
+      assert(stl::upper_bound(v1.begin(), v1.end(), x) == hi);
+      assert(stl::equal_range(v1, x) == std::make_pair(lo, hi));
+      assert(stl::binary_search(v1, x) == (lo != hi));
+      assert(stl::distance(l1.begin(), stl::lower_bound(l1, x)) == lo - v1.begin());
+      assert(stl::distance(l1.begin(), stl::upper_bound(l1, x)) == hi - v1.begin());
+      assert(stl::binary_search(l1, x) == (lo != hi));
+    }
+
+    std::vector<int> keys;
+    for (int x = -1; x <= n / 3 + 1; ++x)
+      keys.push_back(x);
+    std::vector<std::vector<int>::iterator> out(keys.size());
+    assert(stl::batch_lower_bound(v1, keys, out.begin()) == out.end());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      assert(out[i] == stl::lower_bound(v1, keys[i]));
+    std::vector<std::list<int>::iterator> out2(keys.size());
+    stl::batch_lower_bound(l1, keys, out2.begin());
+    assert(out2.back() == l1.end());
+  }
+
+  std::vector<pair> v2 {{1, 'a'}, {3, 'b'}, {3, 'c'}, {5, 'd'}};
+  assert(stl::lower_bound(v2, 3, stl::less<>(), key)->value == 'b');
+  assert(stl::upper_bound(v2, 3, stl::less<>(), key)->value == 'd');
+  assert(!stl::binary_search(v2, 4, stl::less<>(), key));
+
+  std::vector<int> v3 {5, 3, 1};
+  assert(stl::lower_bound(v3, 3, stl::greater<>()) == v3.begin() + 1);
+}
+
+
+void
+test_member_projection()
+{
+  // Pointers to data members project by reference.
+  std::vector<pair> v1 {{3, 'a'}, {1, 'b'}, {4, 'c'}, {1, 'd'}, {5, 'e'}};
+  assert(stl::find(v1, 4, &pair::key) == v1.begin() + 2);
+  assert(stl::find(v1, 'e', &pair::value) == v1.begin() + 4);
+  assert(stl::find_if(v1, is_odd, &pair::key) == v1.begin());
+  assert(stl::find_if_not(v1, is_odd, &pair::key) == v1.begin() + 2);
+  assert(stl::any_of(v1, is_pos, &pair::key));
+  assert(stl::none_of({pair{2, 'a'}, pair{4, 'b'}}, is_odd, &pair::key));
+
+  std::vector<pair> v2 = v1;
+  stl::stable_sort(v2, stl::less<>(), &pair::key);
+  assert(v2[0].value == 'b' && v2[1].value == 'd' && v2[4].value == 'e');
+  assert(stl::lower_bound(v2, 4, stl::less<>(), &pair::key)->value == 'c');
+  assert(stl::binary_search(v2, 3, stl::less<>(), &pair::key));
+
+  stl::sort(v1, stl::greater<>(), &pair::value);
+  assert(v1[0].value == 'e' && v1[4].value == 'a');
+
+  std::vector<pair> b1(v1.size());
+  stl::radix_sort(v1, b1, &pair::key);
+  assert(v1[0].key == 1 && v1[4].key == 5);
+
+  // Pointers to member functions are called on the element.
+  std::vector<std::string> v3 {"ccc", "a", "bb"};
+  stl::sort(v3, stl::less<>(), &std::string::size);
+  assert(v3[0] == "a" && v3[2] == "ccc");
+  assert(stl::find(v3, 2u, &std::string::size) == v3.begin() + 1);
+}
+
+
+void
+test_parallel()
+{
+  using stl::execution::seq;
+  using stl::execution::par;
+  using stl::execution::par_unseq;
+  stl::thread_pool pool(4);
+
+  // Long enough to be split between threads.
+  std::vector<int> v1(1 << 20, 2);
+  assert(stl::all_of(par, v1, is_pos));
+  assert(stl::none_of(par.on(pool), v1, is_odd));
+  assert(stl::find(par, v1, 3) == v1.end());
+  v1[700001] = 3;
+  v1[900000] = 3;
+  assert(stl::find(par, v1, 3) == v1.begin() + 700001);
+  assert(stl::find(seq, v1, 3) == v1.begin() + 700001);
+  assert(stl::find(par_unseq, v1.begin(), v1.end(), 3) == v1.begin() + 700001);
+  assert(stl::find_if(par.on(pool), v1, is_odd) == v1.begin() + 700001);
+  assert(stl::any_of(par, v1.begin(), v1.end(), is_odd));
+  assert(!stl::all_of(par, v1, [](int n) { return n == 2; }));
+  v1[5] = -1;
+  assert(stl::find_if_not(par, v1, is_pos) == v1.begin() + 5);
+
+  std::vector<pair> v2(100000, {2, 'a'});
+  v2[99999].key = 3;
+  assert(stl::find(par, v2, 3, key) == v2.begin() + 99999);
+  assert(stl::find_if(par, v2.begin(), v2.end(), is_odd, key) == v2.begin() + 99999);
+  assert(!stl::all_of(par, v2, is_odd, key));
+
+  // Sequences without random access run sequentially.
+  std::list<int> l1 {2, 4, 5};
+  assert(stl::find_if(par, l1, is_odd) == std::prev(l1.end()));
+
+  std::vector<int> v3(1 << 20);
+  for (std::size_t i = 0; i < v3.size(); ++i)
+    v3[i] = i;
+  std::vector<int> v4(v3.size());
+  auto r1 = stl::copy(par, v3, v4.begin());
+  assert(r1.first == v3.end() && r1.second == v4.end());
+  assert(v3 == v4);
+  stl::fill(par, v4, 7);
+  assert(stl::all_of(v4, [](int n) { return n == 7; }));
+  assert(stl::fill_n(par, v4.begin(), 1000, 0) == v4.begin() + 1000);
+  assert(v4[999] == 0 && v4[1000] == 7);
+  stl::copy_n(par, v3.begin(), v3.size(), v4.begin());
+  assert(v3 == v4);
+
+  std::vector<std::string> v5(100000, "abc");
+  std::vector<std::string> v6(v5.size());
+  stl::move(par, v5, v6.begin());
+  assert(v6[0] == "abc" && v6[99999] == "abc");
+
+  // Sizes that give a power of two and an odd number of runs.
+  for (int n : {100, 1 << 20, 3 << 14}) {
+    std::vector<pair> v7(n);
+    unsigned x = 1;
+    for (int i = 0; i < n; ++i) {
+      v7[i].key = (x = x * 1103515245 + 12345) >> 20;
+      v7[i].value = i;
+    }
+    std::vector<pair> v8 = v7;
+    std::vector<pair> v9 = v7;
+    stl::sort(par.on(pool), v7, stl::less<>(), key);
+    assert(std::is_sorted(v7.begin(), v7.end(), [](pair const& a, pair const& b) {
+      return a.key < b.key;
+    }));
+    assert(stl::stable_sort(par, v8.begin(), v8.end(), stl::less<>(), key) == v8.end());
+    std::stable_sort(v9.begin(), v9.end(), [](pair const& a, pair const& b) {
+      return a.key < b.key;
+    });
+    for (int i = 0; i < n; ++i)
+      assert(v8[i].key == v9[i].key && v8[i].value == v9[i].value);
+
+    std::vector<std::string> v10(n);
+    for (int i = 0; i < n; ++i)
+      v10[i] = std::to_string(v9[i].value);
+    stl::sort(par, v10);
+    assert(is_sorted(v10));
+    stl::stable_sort(seq, v10, stl::greater<>());
+    assert(is_sorted(v10, std::greater<std::string>()));
+  }
+}
+
+
 int main()
 {
   // std::vector<int> v1 {1, 2, 3, 4, 5};
   // assert(stl::all_of(v1.begin(), v1.end(), is_pos));
+
+  test_find();
+  test_find_if();
+  test_any_none();
+  test_unguarded();
+  test_segmented();
+  test_copy();
+  test_move();
+  test_fill();
+  test_sort();
+  test_stable_sort();
+  test_radix_sort();
+  test_binary_search();
+  test_member_projection();
+  test_parallel();
 }
@@ -0,0 +1,129 @@
+
+#include <std/execution.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+// Sums [b, e) by splitting it in halves, which nests task groups
+// inside tasks.
+long
+sum(stl::thread_pool& pool, long b, long e)
+{
+  if (e - b <= 1000) {
+    long n = 0;
+    for (long i = b; i < e; ++i)
+      n += i;
+    return n;
+  }
+  long m = b + (e - b) / 2;
+  long x;
+  stl::task_group g(pool);
+  g.run([&]() { x = sum(pool, m, e); });
+  long y = sum(pool, b, m);
+  g.wait();
+  return x + y;
+}
+
+
+void
+test_pool()
+{
+  stl::thread_pool p1(4);
+  assert(p1.size() == 4);
+
+  std::atomic<int> n(0);
+  stl::task_group g1(p1);
+  for (int i = 0; i < 1000; ++i)
+    g1.run([&n]() { ++n; });
+  g1.wait();
+  assert(n == 1000);
+
+  assert(sum(p1, 0, 1000000) == 999999l * 1000000 / 2);
+
+  // A single worker still runs nested tasks.
+  stl::thread_pool p2(1);
+  assert(sum(p2, 0, 100000) == 99999l * 100000 / 2);
+
+  // Pending tasks are run before the pool is destroyed.
+  n = 0;
+  {
+    stl::thread_pool p3(2);
+    for (int i = 0; i < 100; ++i)
+      p3.submit([&n]() { ++n; });
+  }
+  assert(n == 100);
+
+  // Tasks may be move-only.
+  n = 0;
+  stl::task_group g4(p1);
+  for (int i = 0; i < 100; ++i)
+    g4.run([p = std::make_unique<int>(i), &n]() { n += *p; });
+  g4.wait();
+  assert(n == 4950);
+  static_assert(sizeof(stl::thread_pool::task) == 64, "");
+
+  // A waiter blocks while a worker runs the task it waits for, and is
+  // woken when the task is done.
+  std::atomic<bool> started(false);
+  stl::task_group g5(p2);
+  g5.run([&]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    n = -1;
+  });
+  while (!started)
+    std::this_thread::yield();
+  g5.wait();
+  assert(n == -1);
+
+  // A task group stores tasks of up to six pointers without allocating.
+  long a[7];
+  auto six = [&a0 = a[0], &a1 = a[1], &a2 = a[2], &a3 = a[3], &a4 = a[4],
+              &a5 = a[5]]() { a0 = a1 + a2 + a3 + a4 + a5; };
+  auto seven = [six, &a6 = a[6]]() { six(); a6 = 0; };
+  static_assert(stl::task_group::stored_inline<decltype(six)>, "");
+  static_assert(!stl::task_group::stored_inline<decltype(seven)>, "");
+}
+
+
+void
+test_parallel_for()
+{
+  stl::thread_pool pool(3);
+  std::vector<int> v(1000000);
+  stl::impl::parallel_for(pool, v.size(), [&](std::ptrdiff_t b, std::ptrdiff_t e) {
+    for (std::ptrdiff_t i = b; i < e; ++i)
+      ++v[i];
+  });
+  for (int x : v)
+    assert(x == 1);
+}
+
+
+void
+test_policies()
+{
+  static_assert(stl::ExecutionPolicy<decltype(stl::execution::seq)>(), "");
+  static_assert(stl::ExecutionPolicy<decltype(stl::execution::par)>(), "");
+  static_assert(stl::ExecutionPolicy<decltype(stl::execution::par_unseq)&>(), "");
+  static_assert(!stl::ExecutionPolicy<int>(), "");
+
+  stl::thread_pool pool(2);
+  assert(stl::impl::policy_pool(stl::execution::seq) == nullptr);
+  assert(stl::impl::policy_pool(stl::execution::par) == &stl::default_thread_pool());
+  assert(stl::impl::policy_pool(stl::execution::par.on(pool)) == &pool);
+  assert(stl::impl::policy_pool(stl::execution::par_unseq.on(pool)) == &pool);
+}
+
+
+int main()
+{
+  test_pool();
+  test_parallel_for();
+  test_policies();
+}
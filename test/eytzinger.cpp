@@ -0,0 +1,65 @@
+
+#include <std/eytzinger.hpp>
+
+#include <cassert>
+#include <list>
+#include <string>
+#include <vector>
+
+
+void
+test_search()
+{
+  // Perfect and incomplete trees.
+  for (int n : {0, 1, 2, 3, 7, 10, 15, 16, 1000}) {
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i)
+      v[i] = 2 * i;
+    stl::eytzinger_index<int> idx(v);
+    assert(idx.size() == std::size_t(n));
+    for (int x = -1; x <= 2 * n; ++x) {
+      int const* p = idx.lower_bound(x);
+      int const* q = idx.upper_bound(x);
+      if (x > 2 * (n - 1))
+        assert(p == idx.end());
+      else
+        assert(*p == (x + 1) / 2 * 2);
+      if (x >= 2 * (n - 1))
+        assert(q == idx.end());
+      else
+        assert(*q == (x < 0 ? 0 : x / 2 * 2 + 2));
+      assert(idx.contains(x) == (x >= 0 && x % 2 == 0 && x < 2 * n));
+    }
+
+    std::vector<int> keys;
+    for (int x = -1; x <= 2 * n; ++x)
+      keys.push_back(x);
+    std::vector<int const*> out(keys.size());
+    assert(idx.batch_lower_bound(keys, out.begin()) == out.end());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      assert(out[i] == idx.lower_bound(keys[i]));
+  }
+}
+
+
+void
+test_order()
+{
+  std::list<std::string> l {"c", "b", "a"};
+  stl::eytzinger_index<std::string, stl::greater<>> idx(l);
+  assert(*idx.begin() == "b");
+  assert(*idx.lower_bound("bb") == "b");
+  assert(idx.lower_bound("0") == idx.end());
+  assert(!idx.contains("d"));
+  assert(idx.contains(std::string("a")));
+
+  stl::eytzinger_index<int> empty;
+  assert(empty.empty() && empty.lower_bound(1) == empty.end());
+}
+
+
+int main()
+{
+  test_search();
+  test_order();
+}
@@ -0,0 +1,149 @@
+
+#include <std/flat_hash.hpp>
+
+#include <cassert>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+void
+test_map()
+{
+  stl::flat_hash_map<int, int> m1;
+  assert(m1.empty() && m1.find(3) == m1.end());
+  for (int i = 0; i < 1000; ++i)
+    m1[i] = 2 * i;
+  assert(m1.size() == 1000);
+  for (int i = 0; i < 1000; ++i)
+    assert(m1.at(i) == 2 * i);
+  int n = 0;
+  for (auto& [k, v] : m1) {
+    assert(v == 2 * k);
+    ++n;
+  }
+  assert(n == 1000);
+
+  assert(!m1.insert({1, 0}).second);
+  assert(m1.try_emplace(1000, 7).second && m1[1000] == 7);
+  for (int i = 0; i < 1000; i += 2)
+    assert(m1.erase(i) == 1);
+  assert(m1.erase(0) == 0);
+  assert(m1.size() == 501 && !m1.contains(4) && m1.contains(5));
+
+  for (auto i = m1.begin(); i != m1.end(); )
+    i = m1.erase(i);
+  assert(m1.empty());
+
+  // Values may be move-only.
+  stl::flat_hash_map<int, std::unique_ptr<int>> m2;
+  for (int i = 0; i < 100; ++i)
+    m2.try_emplace(i, new int(i));
+  assert(*m2.at(42) == 42);
+
+  auto m3 = stl::flat_hash_map<int, int> {{1, 2}, {3, 4}};
+  auto m4 = m3;
+  m3.clear();
+  assert(m3.empty() && m4.size() == 2 && m4.at(3) == 4);
+}
+
+
+// Random inserts and erases, checked against std::unordered_map. Erases
+// leave tombstones, which rehashing clears.
+void
+test_random()
+{
+  std::mt19937 g(1);
+  std::unordered_map<int, int> ref;
+  stl::flat_hash_map<int, int> m;
+  for (int i = 0; i < 200000; ++i) {
+    int k = g() % 5000;
+    if (g() % 3) {
+      m[k] = i;
+      ref[k] = i;
+    } else {
+      assert(m.erase(k) == ref.erase(k));
+    }
+  }
+  assert(m.size() == ref.size());
+  for (auto& [k, v] : ref)
+    assert(m.at(k) == v);
+  std::size_t n = 0;
+  for (auto i = m.cbegin(); i != m.cend(); ++i)
+    ++n;
+  assert(n == ref.size());
+  assert(m.load_factor() <= 0.875f);
+}
+
+
+void
+test_reserve()
+{
+  // Inserting the reserved number of elements does not rehash.
+  for (std::size_t n : {1, 14, 15, 1000, 100000}) {
+    stl::flat_hash_map<std::size_t, std::size_t> m;
+    m.reserve(n);
+    std::size_t c = m.capacity();
+    auto p = &*m.try_emplace(0, 0).first;
+    for (std::size_t i = 1; i < n; ++i)
+      m.try_emplace(i, i);
+    assert(m.capacity() == c);
+    assert(p == &*m.find(0));
+  }
+}
+
+
+void
+test_heterogeneous()
+{
+  stl::flat_hash_map<std::string, int> m;
+  for (int i = 0; i < 1000; ++i)
+    m.try_emplace(std::to_string(i), i);
+  std::string_view k = "17";
+  assert(m.find(k)->second == 17);
+  assert(m.contains(std::string_view("999")));
+  assert(m.count(std::string_view("1000")) == 0);
+  assert(m.erase(std::string_view("17")) == 1 && !m.contains("17"));
+
+  // String literals, pointers and arrays of characters are hashed as the
+  // strings they compare equal to.
+  assert(m.contains("999") && m.find("42")->second == 42);
+  char const* p = "123";
+  char a[8] = "500";
+  assert(m.contains(p) && m.contains(a) && !m.contains("1000"));
+  assert(m.erase("999") == 1 && !m.contains("999"));
+
+  // Arithmetic lookups are converted to the key type before hashing.
+  stl::flat_hash_map<std::size_t, int> m2 {{0, 1}, {1, 2}};
+  assert(m2.find(0)->second == 1 && m2.contains(1) && m2.count(short(1)) == 1);
+  assert(m2.erase(1) == 1 && !m2.contains(1));
+  stl::flat_hash_map<double, int> m3 {{2.0, 3}};
+  assert(m3.contains(2) && m3.find(2)->second == 3);
+
+  // Pointer keys are hashed and compared by address, even if they point
+  // to characters.
+  char buf[2] = {'x', 'y'};
+  stl::flat_hash_set<char*> s2 {buf, buf + 1, nullptr};
+  char const* q = buf;
+  assert(s2.size() == 3 && s2.contains(buf + 1) && s2.contains(nullptr));
+  stl::flat_hash_set<char const*> s3 {q};
+  assert(s3.contains(buf) && !s3.contains("x"));
+
+  stl::flat_hash_set<std::string> s {"a", "b", "a"};
+  assert(s.size() == 2);
+  assert(s.count(std::string_view("b")) == 1);
+  assert(s.count("a") == 1 && s.count("d") == 0);
+  assert(!s.insert("b").second && s.insert("c").second);
+  static_assert(std::is_same<decltype(*s.begin()), std::string const&>::value, "");
+}
+
+
+int main()
+{
+  test_map();
+  test_random();
+  test_reserve();
+  test_heterogeneous();
+}
@@ -2,10 +2,161 @@
 #include <std/functional.hpp>
 
 #include <cassert>
+#include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 
+struct record
+{
+  int key;
+
+  int get() const noexcept { return key; }
+  int add(int n) { return key += n; }
+};
+
+struct derived : record { };
+
+// Has the interface of a reference wrapper, but is not one.
+struct handle
+{
+  using type = record;
+  record* rec;
+  int id;
+
+  record& get() const { return *rec; }
+  operator record&() const { return *rec; }
+};
+
+int twice(int n) { return 2 * n; }
+void incr(int& n) { ++n; }
+
+int apply(stl::function_ref<int(int)> f, int n) { return f(n); }
+
+
+void
+test_invoke()
+{
+  record r {3};
+  record const& cr = r;
+  record* p = &r;
+  derived d;
+  d.key = 4;
+
+  // Data members are projected by reference, with the cv-qualification
+  // and value category of the object.
+  static_assert(std::is_same<stl::invoke_result_t<int record::*, record&>, int&>::value, "");
+  static_assert(std::is_same<stl::invoke_result_t<int record::*, record const&>, int const&>::value, "");
+  static_assert(std::is_same<stl::invoke_result_t<int record::*, record>, int&&>::value, "");
+  static_assert(std::is_same<stl::invoke_result_t<int record::*, record*>, int&>::value, "");
+  static_assert(noexcept(stl::invoke(&record::key, r)), "");
+  assert(&stl::invoke(&record::key, r) == &r.key);
+  assert(&stl::invoke(&record::key, cr) == &r.key);
+  assert(stl::invoke(&record::key, p) == 3);
+  assert(stl::invoke(&record::key, std::ref(r)) == 3);
+  assert(stl::invoke(&record::key, d) == 4);
+  handle h {&r, 5};
+  assert(stl::invoke(&handle::id, h) == 5);
+  static_assert(stl::impl::is_reference_wrapper<handle>::value, "");
+
+  // Member functions are called on the object.
+  static_assert(noexcept(stl::invoke(&record::get, r)), "");
+  assert(stl::invoke(&record::get, cr) == 3);
+  assert(stl::invoke(&record::add, p, 2) == 5);
+  assert(stl::invoke(&record::add, std::ref(r), 1) == 6);
+  assert(stl::invoke(&std::string::size, std::string("abc")) == 3);
+
+  // Anything else is called directly.
+  auto twice = [](int n) constexpr { return 2 * n; };
+  static_assert(stl::invoke(twice, 2) == 4, "");
+  assert(stl::invoke(stl::identity_fn(), 7) == 7);
+  assert(stl::invoke(stl::less<>(), 1, 2));
+}
+
+
+void
+test_function_ref()
+{
+  static_assert(sizeof(stl::function_ref<int(int)>) == 2 * sizeof(void*), "");
+
+  // Functions, by name or by pointer.
+  assert(apply(twice, 3) == 6);
+  assert(apply(&twice, 3) == 6);
+  stl::function_ref<void(int&)> f1 = incr;
+  int n = 1;
+  f1(n);
+  assert(n == 2);
+
+  // Function objects are referred to, not copied.
+  auto add = [&n](int k) { return n + k; };
+  assert(apply(add, 1) == 3);
+  n = 10;
+  assert(apply(add, 1) == 11);
+  auto const cadd = add;
+  assert(apply(cadd, 1) == 11);
+  assert(apply([](int k) { return k - 1; }, 1) == 0);
+
+  // The result is converted, or discarded.
+  stl::function_ref<long(short)> f2 = twice;
+  assert(f2(4) == 8);
+  stl::function_ref<void(int)> f3 = twice;
+  f3(4);
+
+  // Anything invocable, including pointers to members.
+  auto key = &record::key;
+  stl::function_ref<int(record const&)> f4 = key;
+  assert(f4(record {5}) == 5);
+
+  stl::function_ref<int(int)> f5 = add;
+  f5 = twice;
+  assert(f5(2) == 4);
+}
+
+
+void
+test_unique_function()
+{
+  stl::unique_function<int(int)> f1;
+  assert(!f1);
+  f1 = twice;
+  assert(f1 && f1(3) == 6);
+
+  // Move-only callables, stored inline.
+  stl::unique_function<int()> f2 = [p = std::make_unique<int>(5)]() { return *p; };
+  stl::unique_function<int()> f3 = std::move(f2);
+  assert(!f2 && f3() == 5);
+
+  // Callables that are not trivially relocatable are moved.
+  std::string s(100, 'x');
+  stl::unique_function<std::size_t()> f4 = [s]() { return s.size(); };
+  auto f5 = std::move(f4);
+  assert(f5() == 100);
+
+  // Larger callables are allocated, unless the buffer is large enough.
+  long a[8] = {1, 2};
+  stl::unique_function<long()> f6 = [a]() { return a[1]; };
+  auto f7 = std::move(f6);
+  assert(f7() == 2);
+  stl::unique_function<long(), sizeof(a)> f8 = [a]() { return a[0]; };
+  assert(f8() == 1);
+
+  std::vector<stl::unique_function<void(int&)>> v;
+  for (int i = 0; i < 100; ++i)
+    v.push_back([i](int& n) { n += i; });
+  int n = 0;
+  for (auto& f : v)
+    f(n);
+  assert(n == 4950);
+
+  // A null pointer is empty.
+  int (*p)(int) = nullptr;
+  stl::unique_function<int(int)> f9 = p;
+  assert(!f9);
+  f1 = nullptr;
+  assert(!f1);
+}
+
 
 int main()
 {
@@ -13,4 +164,8 @@ int main()
   std::less<int> less2;
   assert(less1(1, 2));
   assert(less2(1, 2));
+
+  test_invoke();
+  test_function_ref();
+  test_unique_function();
 }
@@ -0,0 +1,166 @@
+
+#include <std/generator.hpp>
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+stl::generator<int>
+iota(int n)
+{
+  for (int i = 0; i < n; ++i)
+    co_yield i;
+}
+
+stl::generator<long long>
+fibonacci()
+{
+  long long a = 0, b = 1;
+  while (true) {
+    co_yield a;
+    b = a + b;
+    a = b - a;
+  }
+}
+
+stl::generator<std::string&>
+words(std::vector<std::string>& v)
+{
+  for (std::string& s : v)
+    co_yield s;
+}
+
+stl::generator<int>
+failing()
+{
+  co_yield 1;
+  throw std::runtime_error("failed");
+}
+
+
+template<typename R>
+std::vector<int>
+to_vector(R&& r)
+{
+  std::vector<int> v;
+  for (auto i = stl::begin(r); i != stl::end(r); ++i)
+    v.push_back(*i);
+  return v;
+}
+
+
+void
+test_generate()
+{
+  static_assert(stl::InputRange<stl::generator<int>>());
+  static_assert(stl::View<stl::generator<int>>());
+  assert(to_vector(iota(4)) == (std::vector<int> {0, 1, 2, 3}));
+  assert(to_vector(iota(0)).empty());
+
+  // Algorithms.
+  auto g = iota(10);
+  assert(*stl::find(g, 6) == 6);
+  assert(stl::all_of(iota(5), [](int x) { return x < 5; }));
+
+  // Views adapt rvalue generators.
+  auto odd = [](long long x) { return x % 2 != 0; };
+  std::vector<int> f;
+  for (long long x : fibonacci() | stl::view::filter(odd) | stl::view::take(5))
+    f.push_back(x);
+  assert(f == (std::vector<int> {1, 1, 3, 5, 13}));
+
+  // Values are yielded by reference.
+  std::vector<std::string> v {"a", "b"};
+  for (std::string& s : words(v))
+    s += "!";
+  assert(v[0] == "a!" && v[1] == "b!");
+
+  // Postfix increment keeps the value.
+  auto h = iota(3);
+  auto i = h.begin();
+  assert(*i++ == 0 && *i == 1);
+}
+
+
+void
+test_exception()
+{
+  auto g = failing();
+  auto i = g.begin();
+  assert(*i == 1);
+  bool thrown = false;
+  try {
+    ++i;
+  } catch (std::runtime_error const&) {
+    thrown = true;
+  }
+  assert(thrown && i == stl::default_sentinel{});
+}
+
+
+// Allocates frames from a fixed buffer, and counts the allocations.
+int allocations = 0;
+
+template<typename T>
+struct arena_allocator
+{
+  using value_type = T;
+
+  explicit arena_allocator(char* p) : buf(p) { }
+
+  template<typename U>
+  arena_allocator(arena_allocator<U> const& a) : buf(a.buf) { }
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    assert(n * sizeof(T) <= 4096);
+    return reinterpret_cast<T*>(buf);
+  }
+
+  void deallocate(T*, std::size_t) { --allocations; }
+
+  char* buf;
+};
+
+template<typename T, typename U>
+bool operator==(arena_allocator<T> const& a, arena_allocator<U> const& b)
+{
+  return a.buf == b.buf;
+}
+
+template<typename T, typename U>
+bool operator!=(arena_allocator<T> const& a, arena_allocator<U> const& b)
+{
+  return a.buf != b.buf;
+}
+
+stl::generator<int, arena_allocator<char>>
+squares(std::allocator_arg_t, arena_allocator<char>, int n)
+{
+  for (int i = 0; i < n; ++i)
+    co_yield i * i;
+}
+
+void
+test_allocator()
+{
+  alignas(std::max_align_t) static char buf[4096];
+  {
+    auto g = squares(std::allocator_arg, arena_allocator<char>(buf), 4);
+    assert(allocations == 1);
+    assert(to_vector(g) == (std::vector<int> {0, 1, 4, 9}));
+    assert(allocations == 1);
+  }
+  assert(allocations == 0);
+}
+
+
+int main()
+{
+  test_generate();
+  test_exception();
+  test_allocator();
+}
@@ -0,0 +1,210 @@
+
+#include <std/hash.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+struct point
+{
+  int x;
+  int y;
+};
+
+namespace stl
+{
+template<>
+struct is_uniquely_represented<point> : true_type { };
+} // namespace stl
+
+
+struct key
+{
+  long id;
+  std::string name;
+  double weight;
+
+  bool operator==(key const& k) const
+  {
+    return id == k.id && name == k.name && weight == k.weight;
+  }
+
+  template<stl::HashAlgorithm H>
+  friend void hash_append(H& h, key const& k)
+  {
+    using stl::hash_append;
+    hash_append(h, k.id, k.name, k.weight);
+  }
+};
+
+
+// Counts the bytes it is given, and the number of appends.
+struct counter
+{
+  using result_type = std::size_t;
+
+  void operator()(void const*, std::size_t n) { bytes += n; ++calls; }
+  explicit operator result_type() const { return bytes; }
+
+  std::size_t bytes = 0;
+  std::size_t calls = 0;
+};
+
+
+template<typename T>
+std::size_t
+calls(T const& x)
+{
+  using stl::hash_append;
+  counter h;
+  hash_append(h, x);
+  return h.calls;
+}
+
+
+void
+test_representation()
+{
+  static_assert(stl::UniquelyRepresented<int>(), "");
+  static_assert(stl::UniquelyRepresented<char const*>(), "");
+  static_assert(stl::UniquelyRepresented<std::pair<int, int>>(), "");
+  static_assert(stl::UniquelyRepresented<std::tuple<long, long>>(), "");
+  static_assert(stl::UniquelyRepresented<int[4]>(), "");
+  static_assert(stl::UniquelyRepresented<point>(), "");
+  static_assert(!stl::UniquelyRepresented<double>(), "");
+  static_assert(!stl::UniquelyRepresented<std::pair<char, int>>(), "");
+  static_assert(!stl::UniquelyRepresented<std::string>(), "");
+  static_assert(stl::HashAlgorithm<stl::wyhash>(), "");
+  static_assert(stl::HashAlgorithm<stl::fnv1a>(), "");
+  static_assert(stl::HashAlgorithm<counter>(), "");
+
+  // Uniquely represented values are appended in one block.
+  assert(calls(std::pair<int, int>(1, 2)) == 1);
+  assert(calls(std::vector<point>(100)) == 2);
+  assert(calls(std::string(100, 'a')) == 2);
+
+  // Padded values are appended by member.
+  assert(calls(std::pair<char, int>('a', 1)) == 2);
+  assert(calls(std::vector<std::pair<char, int>>(10)) == 21);
+  assert(calls(key {1, "a", 2.0}) == 4);
+}
+
+
+template<typename H>
+void
+check_algorithm()
+{
+  stl::hash<void, H> h;
+
+  // Equal values hash alike.
+  assert(h(42) == h(42));
+  assert(h(std::string("abc")) == h(std::string("abc")));
+  assert(h(0.0) == h(-0.0));
+  assert(h(key {1, "a", 2.0}) == h(key {1, "a", 2.0}));
+
+  // Different values almost never do.
+  assert(h(1) != h(2));
+  assert(h(key {1, "a", 2.0}) != h(key {1, "b", 2.0}));
+  assert(h(std::make_pair(std::string("ab"), std::string("c"))) !=
+         h(std::make_pair(std::string("a"), std::string("bc"))));
+
+  // Keys of every length, across the 16 and 48 byte paths.
+  std::set<std::size_t> seen;
+  std::string s;
+  for (int n = 0; n < 200; ++n) {
+    assert(seen.insert(h(s)).second);
+    s.push_back(static_cast<char>('a' + n % 26));
+  }
+
+  // Flipping any bit of a 32 byte key changes the hash.
+  std::vector<unsigned char> v(32);
+  std::size_t x = h(v);
+  for (std::size_t i = 0; i < 8 * v.size(); ++i) {
+    v[i / 8] ^= 1 << i % 8;
+    assert(h(v) != x);
+    v[i / 8] ^= 1 << i % 8;
+  }
+
+  std::unordered_set<key, stl::hash<key, H>> keys;
+  for (long i = 0; i < 1000; ++i)
+    keys.insert(key {i, std::to_string(i), 0.5});
+  assert(keys.size() == 1000);
+}
+
+
+void
+test_wyhash()
+{
+  check_algorithm<stl::wyhash>();
+
+  // The seed changes the hash.
+  stl::wyhash a;
+  stl::wyhash b(1);
+  a("abc", 3);
+  b("abc", 3);
+  assert(static_cast<std::uint64_t>(a) != static_cast<std::uint64_t>(b));
+
+  // A single append gives the reference results, seeded with the index,
+  // across the 3, 8, 16 and 48 byte paths.
+  char const* inputs[] = {
+    "",
+    "a",
+    "abc",
+    "message digest",
+    "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    "1234567890123456789012345678901234567890"
+    "1234567890123456789012345678901234567890",
+  };
+  std::uint64_t expected[] = {
+    0x93228a4de0eec5a2ull, 0xc5bac3db178713c4ull, 0xa97f2f7b1d9b3314ull,
+    0x786d1f1df3801df4ull, 0xdca5a8138ad37c87ull, 0xb9e734f117cfaf70ull,
+    0x6cc5eab49a92d617ull,
+  };
+  for (int i = 0; i < 7; ++i) {
+    stl::wyhash h(i);
+    h(inputs[i], std::strlen(inputs[i]));
+    assert(static_cast<std::uint64_t>(h) == expected[i]);
+  }
+
+  // Small appends are packed two to a block; every pair still differs.
+  std::set<std::uint64_t> pairs;
+  for (std::uint32_t i = 0; i < 64; ++i)
+    for (std::uint32_t j = 0; j < 64; ++j) {
+      stl::wyhash h;
+      h(&i, sizeof(i));
+      h(&j, sizeof(j));
+      h("x", 1);
+      assert(pairs.insert(static_cast<std::uint64_t>(h)).second);
+    }
+}
+
+
+void
+test_fnv1a()
+{
+  check_algorithm<stl::fnv1a>();
+
+  // Known values.
+  stl::fnv1a h1;
+  assert(static_cast<std::uint64_t>(h1) == 0xcbf29ce484222325ull);
+  h1("a", 1);
+  assert(static_cast<std::uint64_t>(h1) == 0xaf63dc4c8601ec8cull);
+  stl::fnv1a h2;
+  h2("foobar", 6);
+  assert(static_cast<std::uint64_t>(h2) == 0x85944171f73967e8ull);
+}
+
+
+int main()
+{
+  test_representation();
+  test_wyhash();
+  test_fnv1a();
+}
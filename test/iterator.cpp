@@ -1,8 +1,13 @@
 
 #include <std/iterator.hpp>
+#include <std/streambuf_iterator.hpp>
 
+#include <cassert>
+#include <deque>
 #include <forward_list>
 #include <list>
+#include <sstream>
+#include <string>
 #include <vector>
 
 
@@ -23,7 +28,128 @@ static_assert(test_forward_iterator<fiter>());
 static_assert(test_bidirectional_iterator<biter>());
 static_assert(test_random_access_iterator<riter>());
 
+static_assert(stl::ContiguousIterator<int*>());
+static_assert(stl::ContiguousIterator<int const*>());
+static_assert(stl::ContiguousIterator<riter>());
+static_assert(!stl::ContiguousIterator<std::deque<int>::iterator>());
+static_assert(!stl::ContiguousIterator<biter>());
+
+
+void
+test_advance()
+{
+  std::vector<int> v(10);
+  riter i = v.begin();
+  stl::advance(i, v.end());
+  assert(i == v.end());
+
+  i = v.begin();
+  stl::advance(i, 4, v.end());
+  assert(i == v.begin() + 4);
+  stl::advance(i, 100, v.end());
+  assert(i == v.end());
+  stl::advance(i, -3, v.begin());
+  assert(i == v.begin() + 7);
+  stl::advance(i, -100, v.begin());
+  assert(i == v.begin());
+
+  assert(stl::next(v.begin(), 3, v.end()) == v.begin() + 3);
+  assert(stl::next(v.begin(), 30, v.end()) == v.end());
+  assert(stl::next(v.begin(), v.end()) == v.end());
+  assert(stl::prev(v.end(), 30, v.begin()) == v.begin());
+
+  std::list<int> l(5);
+  biter j = l.begin();
+  stl::advance(j, 7, l.end());
+  assert(j == l.end());
+  assert(stl::next(l.begin(), l.end()) == l.end());
+
+  stl::counted_iterator<biter> k(l.begin(), 3);
+  stl::advance(k, stl::default_sentinel());
+  assert(k.cnt == 0 && k.iter == stl::next(l.begin(), 3));
+}
+
+
+void
+test_distance()
+{
+  std::vector<int> v(10);
+  assert(stl::distance(v.begin(), v.end()) == 10);
+  assert(stl::distance(v.end(), v.begin()) == -10);
+
+  std::list<int> l(5);
+  assert(stl::distance(l.begin(), l.end()) == 5);
+}
+
+
+void
+test_common_iterator()
+{
+  using C = stl::common_iterator<stl::counted_iterator<riter>, stl::default_sentinel>;
+  static_assert(stl::ForwardIterator<C>());
+
+  std::vector<int> v {1, 2, 3, 4};
+  C first(stl::counted_iterator<riter>(v.begin(), 3));
+  C last(stl::default_sentinel{});
+  assert(first != last && last == last);
+
+  // Standard algorithms accept the pair.
+  assert(std::distance(first, last) == 3);
+  assert(std::vector<int>(first, last) == (std::vector<int> {1, 2, 3}));
+
+  C i = first;
+  ++i;
+  assert(*i == 2 && i != first);
+  i = last;
+  assert(i == last && i.is_sentinel());
+  i = first;
+  assert(i == first && !i.is_sentinel());
+
+  // The sentinel shares storage with the iterator.
+  static_assert(sizeof(stl::common_iterator<int*, stl::unreachable_sentinel>) ==
+                2 * sizeof(int*));
+  using D = stl::common_iterator<riter, stl::unreachable_sentinel>;
+  D a(v.begin());
+  D b(stl::unreachable_sentinel{});
+  assert(a != b && b == b && a == D(v.begin()));
+}
+
+
+void
+test_streambuf_iterator()
+{
+  using I = stl::istreambuf_iterator<char>;
+  using O = stl::ostreambuf_iterator<char>;
+  static_assert(stl::InputIterator<I>());
+  static_assert(stl::Sentinel<stl::default_sentinel, I>());
+  static_assert(stl::OutputIterator<O, char>());
+
+  std::istringstream in("abc");
+  I i(in);
+  assert(i != stl::default_sentinel{} && *i == 'a');
+  assert(*i++ == 'a' && *i == 'b');
+  ++i;
+  assert(*i == 'c' && i != I());
+  ++i;
+  assert(i == stl::default_sentinel{} && i == I());
+
+  std::istringstream empty;
+  assert(I(empty) == stl::default_sentinel{});
+
+  // Copy a stream through the buffers.
+  std::istringstream src("hello, world");
+  std::ostringstream dst;
+  O o(dst);
+  for (I j(src); j != stl::default_sentinel{}; ++j)
+    *o++ = *j;
+  assert(!o.failed() && dst.str() == "hello, world");
+}
+
 
 int main()
 {
+  test_advance();
+  test_distance();
+  test_common_iterator();
+  test_streambuf_iterator();
 }
@@ -0,0 +1,89 @@
+
+#include <std/mmap.hpp>
+#include <std/algorithm.hpp>
+#include <std/view.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#include <unistd.h>
+
+
+// Writes s to a temporary file and returns its name.
+std::string
+write_file(std::string const& s)
+{
+  char name[] = "/tmp/stl_mmap_XXXXXX";
+  int fd = ::mkstemp(name);
+  assert(fd >= 0);
+  assert(::write(fd, s.data(), s.size()) == ssize_t(s.size()));
+  ::close(fd);
+  return name;
+}
+
+
+void
+test_map()
+{
+  std::string s = "first line\nsecond line\nthird\n";
+  std::string name = write_file(s);
+  {
+    stl::mmap_range m(name);
+    static_assert(stl::ContiguousRange<stl::mmap_range const>());
+    assert(m.size() == s.size());
+    assert(std::string(m.begin(), m.end()) == s);
+
+    // Algorithms search the mapping directly.
+    char const* nl = stl::find(m, '\n');
+    assert(nl - m.data() == 10);
+    assert(stl::find(m, 'z') == m.end());
+    std::string w = "line";
+    assert(stl::search(m, w) == m.data() + 6);
+
+    // Views over the mapping.
+    auto t = m | stl::view::take_while([](char c) { return c != ' '; });
+    std::string first;
+    for (char c : t)
+      first += c;
+    assert(first == "first");
+
+    m.advise(stl::mmap_advice::random);
+
+    // Moving transfers the mapping.
+    stl::mmap_range n(std::move(m));
+    assert(m.empty() && m.data() == nullptr);
+    assert(n.size() == s.size() && n.data()[0] == 'f');
+    m = std::move(n);
+    assert(m.size() == s.size() && n.empty());
+  }
+  std::remove(name.c_str());
+
+  // An empty file is an empty range.
+  name = write_file("");
+  stl::mmap_range e(name);
+  assert(e.empty() && e.begin() == e.end());
+  std::remove(name.c_str());
+}
+
+
+void
+test_error()
+{
+  bool thrown = false;
+  try {
+    stl::mmap_range m("/nonexistent/stl_mmap");
+  } catch (std::system_error const& e) {
+    thrown = e.code().value() == ENOENT;
+  }
+  assert(thrown);
+}
+
+
+int main()
+{
+  test_map();
+  test_error();
+}
@@ -0,0 +1,173 @@
+
+#include <std/numeric.hpp>
+
+#include <cassert>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+
+struct item
+{
+  int count;
+  double price;
+};
+
+int count(item const& x) { return x.count; }
+double price(item const& x) { return x.price; }
+
+
+void
+test_reduce()
+{
+  // Sizes on both sides of the number of accumulators.
+  for (int n : {0, 1, 7, 8, 9, 100, 1003}) {
+    std::vector<int> v1(n);
+    for (int i = 0; i < n; ++i)
+      v1[i] = i;
+    assert(stl::reduce(v1, 0) == n * (n - 1) / 2);
+    assert(stl::reduce(v1.begin(), v1.end(), 10) == 10 + n * (n - 1) / 2);
+    assert(stl::reduce(v1, 0ll, stl::plus<>(), [](int x) { return x * 2; }) ==
+           n * (n - 1));
+  }
+
+  std::list<int> l1 {1, 2, 3, 4};
+  assert(stl::reduce(l1, 1, stl::multiplies<>()) == 24);
+
+  // Segmented: block by block.
+  std::deque<int> d1;
+  for (int i = 0; i < 1000; ++i)
+    d1.push_front(i);
+  assert(stl::reduce(d1, 0) == 999 * 1000 / 2);
+  assert(stl::reduce(d1.begin() + 1, d1.end() - 1, 0) == 998 * 999 / 2);
+
+  std::vector<std::string> v2 {"a", "b", "c"};
+  assert(stl::reduce(v2, std::string()).size() == 3);
+
+  std::vector<item> v3 {{1, 0.5}, {2, 1.5}, {3, 2.0}};
+  assert(stl::reduce(v3, 0, stl::plus<>(), count) == 6);
+}
+
+
+void
+test_transform_reduce()
+{
+  std::vector<item> v1 {{1, 0.5}, {2, 1.5}, {3, 2.0}};
+  auto total = [](item const& x) { return x.count * x.price; };
+  assert(stl::transform_reduce(v1, 0.0, stl::plus<>(), total) == 9.5);
+  assert(stl::transform_reduce(v1.begin(), v1.end(), 0, stl::plus<>(),
+                               [](int n) { return n * n; }, count) == 14);
+
+  std::vector<int> v2(100, 2);
+  std::vector<int> v3(100, 3);
+  assert(stl::transform_reduce(v2, v3.begin(), 0) == 600);
+  assert(stl::transform_reduce(v2.begin(), v2.end(), v3.begin(), 1,
+                               stl::plus<>(), stl::plus<>()) == 501);
+  assert(stl::transform_reduce(v1, v1.begin(), 0.0, stl::plus<>(),
+                               stl::multiplies<>(), count, price) == 9.5);
+  assert(stl::transform_reduce(v1, v1.begin(), 0.0, stl::plus<>(),
+                               stl::multiplies<>(), &item::count, &item::price) == 9.5);
+  assert(stl::transform_reduce(v1.begin(), v1.end(), v1.begin(), 0,
+                               stl::plus<>(), stl::plus<>(), &item::count,
+                               &item::count) == 12);
+  assert(stl::transform_reduce(stl::execution::par, v1, v1.begin(), 0.0,
+                               stl::plus<>(), stl::multiplies<>(),
+                               &item::count, &item::price) == 9.5);
+  assert(stl::transform_reduce(stl::execution::par, v1.begin(), v1.end(),
+                               v1.begin(), 0, stl::plus<>(), stl::plus<>(),
+                               &item::count, &item::count) == 12);
+
+  std::list<int> l1 {1, 2, 3};
+  assert(stl::transform_reduce(l1, v3.begin(), 0) == 18);
+}
+
+
+void
+test_scan()
+{
+  std::vector<int> v1 {1, 2, 3, 4};
+  std::vector<int> v2(4);
+  auto r1 = stl::inclusive_scan(v1, v2.begin());
+  assert(r1.first == v1.end() && r1.second == v2.end());
+  assert((v2 == std::vector<int> {1, 3, 6, 10}));
+  stl::exclusive_scan(v1.begin(), v1.end(), v2.begin(), 10);
+  assert((v2 == std::vector<int> {10, 11, 13, 16}));
+  stl::inclusive_scan(v1, v2.begin(), stl::multiplies<>());
+  assert((v2 == std::vector<int> {1, 2, 6, 24}));
+
+  // In place.
+  stl::exclusive_scan(v1, v1.begin(), 0);
+  assert((v1 == std::vector<int> {0, 1, 3, 6}));
+
+  std::vector<item> v3 {{1, 0.5}, {2, 1.5}, {3, 2.0}};
+  std::list<int> l1(3);
+  stl::inclusive_scan(v3, l1.begin(), stl::plus<>(), count);
+  assert(l1.back() == 6);
+  std::vector<double> v4(3);
+  stl::exclusive_scan(v3, v4.begin(), 0.0, stl::plus<>(), price);
+  assert(v4[0] == 0.0 && v4[2] == 2.0);
+
+  std::vector<int> v5;
+  assert(stl::inclusive_scan(v5, v2.begin()).second == v2.begin());
+}
+
+
+void
+test_parallel()
+{
+  using stl::execution::par;
+  stl::thread_pool pool(4);
+
+  // Sizes that are and are not split into tiles.
+  for (long n : {0l, 1000l, 1l << 20, (1l << 20) + 13}) {
+    std::vector<long> v1(n);
+    for (long i = 0; i < n; ++i)
+      v1[i] = i % 1000;
+    long sum = 0;
+    for (long x : v1)
+      sum += x;
+    assert(stl::reduce(par, v1, 0l) == sum);
+    assert(stl::reduce(par.on(pool), v1.begin(), v1.end(), 5l) == sum + 5);
+    assert(stl::transform_reduce(par, v1, 0l, stl::plus<>(),
+                                 [](long x) { return 2 * x; }) == 2 * sum);
+    assert(stl::transform_reduce(par, v1, v1.begin(), 0l, stl::plus<>(),
+                                 [](long a, long b) { return a - b; }) == 0);
+
+    std::vector<long> v2(n);
+    stl::inclusive_scan(par.on(pool), v1, v2.begin());
+    long acc = 0;
+    for (long i = 0; i < n; ++i) {
+      acc += v1[i];
+      assert(v2[i] == acc);
+    }
+    stl::exclusive_scan(par, v1.begin(), v1.end(), v2.begin(), 7l);
+    acc = 7;
+    for (long i = 0; i < n; ++i) {
+      assert(v2[i] == acc);
+      acc += v1[i];
+    }
+
+    // In place, with a projection.
+    std::vector<long> v3 = v1;
+    stl::inclusive_scan(par, v3, v3.begin(), stl::plus<>(),
+                        [](long x) { return x + 1; });
+    acc = 0;
+    for (long i = 0; i < n; ++i) {
+      acc += v1[i] + 1;
+      assert(v3[i] == acc);
+    }
+  }
+
+  std::vector<std::string> v4(100000, "x");
+  assert(stl::reduce(par, v4, std::string()).size() == 100000);
+}
+
+
+int main()
+{
+  test_reduce();
+  test_transform_reduce();
+  test_scan();
+  test_parallel();
+}
@@ -0,0 +1,424 @@
+
+#include <std/view.hpp>
+#include <std/algorithm.hpp>
+
+#include <cassert>
+#include <forward_list>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+auto odd = [](int x) { return x % 2 != 0; };
+auto square = [](int x) { return x * x; };
+
+template<typename R>
+std::vector<int>
+to_vector(R&& r)
+{
+  std::vector<int> v;
+  for (auto i = stl::begin(r); i != stl::end(r); ++i)
+    v.push_back(*i);
+  return v;
+}
+
+
+void
+test_transform()
+{
+  std::vector<int> v {1, 2, 3, 4};
+  auto t = stl::view::transform(v, square);
+  static_assert(stl::RandomAccessRange<decltype(t)>());
+  static_assert(stl::SizedRange<decltype(t)>());
+  static_assert(stl::BoundedRange<decltype(t)>());
+  assert(t.size() == 4);
+  assert(to_vector(t) == (std::vector<int> {1, 4, 9, 16}));
+  assert(t.begin()[2] == 9 && t.end() - t.begin() == 4);
+
+  // Const iteration.
+  auto const& c = t;
+  assert(*stl::next(c.begin()) == 4);
+
+  // Transformed elements work with the algorithms.
+  assert(stl::find(t, 9) == t.begin() + 2);
+  assert(stl::all_of(t, [](int x) { return x > 0; }));
+}
+
+
+void
+test_filter()
+{
+  std::vector<int> v {2, 1, 4, 3, 6, 5};
+  auto f = stl::view::filter(v, odd);
+  static_assert(stl::BidirectionalRange<decltype(f)>());
+  static_assert(!stl::RandomAccessRange<decltype(f)>());
+  static_assert(!stl::SizedRange<decltype(f)>());
+  assert(to_vector(f) == (std::vector<int> {1, 3, 5}));
+  assert(*stl::prev(f.end()) == 5);
+
+  // begin() is cached, and refers to the underlying range.
+  assert(f.begin() == f.begin());
+  assert(f.begin().base() == v.begin() + 1);
+
+  // A copy does not share the cache.
+  auto g = f;
+  assert(g.begin().base() == v.begin() + 1);
+
+  std::vector<int> e {2, 4};
+  auto h = stl::view::filter(e, odd);
+  assert(h.begin() == h.end());
+}
+
+
+void
+test_take_drop()
+{
+  std::vector<int> v {1, 2, 3, 4, 5};
+
+  // Random access and sized: the underlying iterators.
+  auto t = stl::view::take(v, 3);
+  static_assert(stl::SameAs<stl::iterator_t<decltype(t)>, std::vector<int>::iterator>());
+  assert(t.size() == 3);
+  assert(to_vector(t) == (std::vector<int> {1, 2, 3}));
+  assert(stl::view::take(v, 10).size() == 5);
+
+  // Sized: counted iterators.
+  std::list<int> l {1, 2, 3, 4, 5};
+  auto tl = stl::view::take(l, 2);
+  static_assert(stl::SizedRange<decltype(tl)>());
+  assert(to_vector(tl) == (std::vector<int> {1, 2}));
+  assert(to_vector(stl::view::take(l, 7)).size() == 5);
+
+  // Unsized: stops at the count or the end.
+  std::forward_list<int> fl {1, 2, 3};
+  assert(to_vector(stl::view::take(fl, 2)) == (std::vector<int> {1, 2}));
+  assert(to_vector(stl::view::take(fl, 9)) == (std::vector<int> {1, 2, 3}));
+
+  auto d = stl::view::drop(v, 2);
+  assert(d.size() == 3);
+  assert(to_vector(d) == (std::vector<int> {3, 4, 5}));
+  assert(stl::view::drop(v, 9).size() == 0);
+  assert(to_vector(stl::view::drop(fl, 1)) == (std::vector<int> {2, 3}));
+  assert(to_vector(stl::view::drop(fl, 5)).empty());
+}
+
+
+void
+test_while()
+{
+  std::vector<int> v {1, 3, 4, 5, 6};
+  assert(to_vector(stl::view::take_while(v, odd)) == (std::vector<int> {1, 3}));
+  assert(to_vector(stl::view::drop_while(v, odd)) == (std::vector<int> {4, 5, 6}));
+
+  std::vector<int> w {1, 3};
+  assert(to_vector(stl::view::take_while(w, odd)) == w);
+  assert(to_vector(stl::view::drop_while(w, odd)).empty());
+}
+
+
+void
+test_pipe()
+{
+  std::vector<int> v {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  auto r = v | stl::view::filter(odd) | stl::view::transform(square)
+             | stl::view::take(3);
+  assert(to_vector(r) == (std::vector<int> {1, 9, 25}));
+
+  // Composed adaptors.
+  auto odd_squares = stl::view::filter(odd) | stl::view::transform(square);
+  assert(to_vector(v | odd_squares | stl::view::drop(3)) ==
+         (std::vector<int> {49, 81}));
+
+  auto less_than = [](int n) { return [n](int x) { return x < n; }; };
+  auto w = v | stl::view::drop_while(less_than(3))
+             | stl::view::take_while(less_than(7));
+  assert(to_vector(w) == (std::vector<int> {3, 4, 5, 6}));
+
+  // A view of a view keeps the inner view by value.
+  auto t = v | stl::view::take(4);
+  auto u = t | stl::view::transform(square);
+  assert(u.size() == 4 && to_vector(u).back() == 16);
+
+  // Range-based for.
+  int sum = 0;
+  for (int x : v | stl::view::transform(square) | stl::view::filter(odd))
+    sum += x;
+  assert(sum == 1 + 9 + 25 + 49 + 81);
+}
+
+
+void
+test_bounded()
+{
+  std::forward_list<int> fl {1, 2, 3, 4};
+  auto t = stl::view::take(fl, 3);
+  static_assert(!stl::BoundedRange<decltype(t)>());
+  auto b = t | stl::view::bounded;
+  static_assert(stl::BoundedRange<decltype(b)>());
+  assert(std::accumulate(b.begin(), b.end(), 0) == 6);
+
+  std::vector<int> v {1, 3, 4, 5};
+  auto w = stl::view::bounded(stl::view::take_while(v, odd));
+  assert(std::vector<int>(w.begin(), w.end()) == (std::vector<int> {1, 3}));
+
+  // Bounded ranges are not wrapped.
+  auto u = v | stl::view::bounded;
+  static_assert(stl::SameAs<decltype(u.begin()), std::vector<int>::iterator>());
+}
+
+
+void
+test_counted()
+{
+  // Random access: a subrange of the underlying iterators.
+  std::vector<int> v {1, 2, 3, 4, 5};
+  auto c = stl::view::counted(v.begin() + 1, 3);
+  static_assert(stl::SameAs<decltype(c.begin()), std::vector<int>::iterator>());
+  static_assert(stl::BoundedRange<decltype(c)>());
+  static_assert(stl::ContiguousRange<decltype(c)>());
+  assert(c.size() == 3 && c.data() == v.data() + 1);
+  assert(to_vector(c) == (std::vector<int> {2, 3, 4}));
+  assert(stl::find(c, 4) == v.begin() + 3);
+  assert(stl::find(c, 5) == c.end());
+
+  auto e = stl::view::counted(v.data(), 0);
+  assert(e.empty() && e.size() == 0 && stl::find(e, 1) == e.end());
+
+  // Otherwise: counted iterators.
+  std::list<int> l {1, 2, 3, 4};
+  auto cl = stl::view::counted(l.begin(), 2);
+  static_assert(stl::SameAs<decltype(cl.begin()), stl::counted_iterator<std::list<int>::iterator>>());
+  assert(to_vector(cl) == (std::vector<int> {1, 2}));
+  assert(to_vector(cl | stl::view::transform(square)) == (std::vector<int> {1, 4}));
+}
+
+
+template<typename R>
+std::vector<std::string>
+fields(R&& r)
+{
+  std::vector<std::string> v;
+  for (auto f : r)
+    v.emplace_back(f.begin(), f.end());
+  return v;
+}
+
+void
+test_split()
+{
+  using S = std::vector<std::string>;
+  std::string s = "a,bc,,d";
+  auto f = stl::view::split(s, ',');
+  static_assert(stl::ForwardRange<decltype(f)>());
+  assert(fields(f) == (S {"a", "bc", "", "d"}));
+  std::string t = ",a,";
+  assert(fields(t | stl::view::split(',')) == (S {"", "a", ""}));
+  std::string e;
+  assert(fields(stl::view::split(e, ',')).empty());
+
+  // Fields refer to the source.
+  auto i = f.begin();
+  ++i;
+  assert((*i).data() == s.data() + 2 && (*i).size() == 2);
+
+  // Lines do not end with an empty line.
+  std::string text = "one\ntwo\n\nthree\n";
+  assert(fields(text | stl::view::lines) == (S {"one", "two", "", "three"}));
+  std::string last = "one\ntwo";
+  assert(fields(stl::view::lines(last)) == (S {"one", "two"}));
+
+  // Other forward ranges.
+  std::forward_list<int> fl {1, 0, 2, 3, 0};
+  std::vector<std::vector<int>> g;
+  for (auto r : stl::view::split(fl, 0))
+    g.push_back(to_vector(r));
+  assert(g == (std::vector<std::vector<int>> {{1}, {2, 3}, {}}));
+
+  // With the algorithms.
+  auto digits = [](char c) { return c >= '0' && c <= '9'; };
+  std::string nums = "12 345 6";
+  assert(stl::all_of(nums | stl::view::split(' '), [&](auto w) {
+    return stl::all_of(w, digits);
+  }));
+}
+
+
+void
+test_zip()
+{
+  std::vector<int> k {3, 1, 2};
+  std::vector<std::string> p {"c", "a", "b"};
+  auto z = stl::view::zip(k, p);
+  static_assert(stl::RandomAccessRange<decltype(z)>());
+  static_assert(stl::BoundedRange<decltype(z)>());
+  static_assert(stl::Permutable<stl::iterator_t<decltype(z)>>());
+  assert(z.size() == 3);
+  assert(std::get<1>(*z.begin()) == "c");
+
+  // Sorting the zip sorts the keys and payloads together.
+  stl::sort(z);
+  assert(k == (std::vector<int> {1, 2, 3}));
+  assert(p == (std::vector<std::string> {"a", "b", "c"}));
+  stl::sort(z, stl::greater<>{}, [](auto const& r) { return std::get<1>(r); });
+  assert(k == (std::vector<int> {3, 2, 1}));
+  assert(p == (std::vector<std::string> {"c", "b", "a"}));
+
+  // Assigning through the references.
+  for (auto [x, s] : z) {
+    x *= 10;
+    s += "!";
+  }
+  assert(k == (std::vector<int> {30, 20, 10}) && p[0] == "c!");
+
+  // Elements are moved, not copied, so move-only payloads can be sorted.
+  std::vector<int> k2(100);
+  std::vector<std::unique_ptr<int>> q;
+  for (int i = 0; i < 100; ++i) {
+    k2[i] = (i * 37) % 100;
+    q.push_back(std::make_unique<int>(k2[i]));
+  }
+  auto first = [](auto const& r) { return std::get<0>(r); };
+  stl::sort(stl::view::zip(k2, q), stl::less<>{}, first);
+  for (int i = 0; i < 100; ++i)
+    assert(k2[i] == i && *q[i] == i);
+  stl::stable_sort(stl::view::zip(k2, q), stl::greater<>{}, first);
+  for (int i = 0; i < 100; ++i)
+    assert(k2[i] == 99 - i && *q[i] == 99 - i);
+
+  // As long as the shortest range.
+  std::forward_list<int> fl {1, 2};
+  std::vector<int> w {5, 5, 5};
+  std::vector<int> out;
+  for (auto [a, b, c] : stl::view::zip(k, fl, w))
+    out.push_back(a + b + c);
+  assert(out == (std::vector<int> {36, 27}));
+}
+
+void
+test_enumerate()
+{
+  std::vector<char> v {'a', 'b', 'c'};
+  auto e = v | stl::view::enumerate;
+  static_assert(stl::RandomAccessRange<decltype(e)>());
+  assert(e.size() == 3);
+  std::string s;
+  for (auto [i, c] : e)
+    s += std::to_string(i) + c;
+  assert(s == "0a1b2c");
+  assert(std::get<0>(e.begin()[2]) == 2);
+  assert(std::get<0>(*stl::prev(e.end())) == 2);
+
+  std::forward_list<int> fl {5, 6};
+  int sum = 0;
+  for (auto [i, x] : stl::view::enumerate(fl))
+    sum += i * x;
+  assert(sum == 6);
+}
+
+
+void
+test_chunk_stride()
+{
+  using VV = std::vector<std::vector<int>>;
+  std::vector<int> v {1, 2, 3, 4, 5, 6, 7};
+
+  // Random access and sized: the chunks are indexed.
+  auto c = stl::view::chunk(v, 3);
+  static_assert(stl::RandomAccessRange<decltype(c)>());
+  static_assert(stl::BoundedRange<decltype(c)>());
+  assert(c.size() == 3 && c.end() - c.begin() == 3);
+  VV g;
+  for (auto r : c)
+    g.push_back(to_vector(r));
+  assert(g == (VV {{1, 2, 3}, {4, 5, 6}, {7}}));
+  assert(to_vector(c.begin()[2]) == (std::vector<int> {7}));
+  assert(to_vector(*stl::prev(c.end())) == (std::vector<int> {7}));
+  assert((*c.begin()).data() == v.data());
+  assert(stl::view::chunk(v, 7).size() == 1 && stl::view::chunk(v, 8).size() == 1);
+  std::vector<int> e;
+  assert(stl::view::chunk(e, 4).size() == 0);
+
+  // Otherwise: forward iterators.
+  std::forward_list<int> fl {1, 2, 3, 4, 5};
+  g.clear();
+  for (auto r : fl | stl::view::chunk(2))
+    g.push_back(to_vector(r));
+  assert(g == (VV {{1, 2}, {3, 4}, {5}}));
+  std::list<int> l {1, 2, 3, 4};
+  assert(stl::view::chunk(l, 3).size() == 2);
+
+  auto s = v | stl::view::stride(3);
+  static_assert(stl::RandomAccessRange<decltype(s)>());
+  assert(s.size() == 3);
+  assert(to_vector(s) == (std::vector<int> {1, 4, 7}));
+  assert(s.begin()[1] == 4 && *stl::prev(s.end()) == 7);
+  assert(to_vector(stl::view::stride(v, 2)) == (std::vector<int> {1, 3, 5, 7}));
+  assert(to_vector(stl::view::stride(v, 10)) == (std::vector<int> {1}));
+  assert(to_vector(stl::view::stride(fl, 2)) == (std::vector<int> {1, 3, 5}));
+  assert(stl::view::stride(l, 3).size() == 2);
+
+  // Writing through a stride.
+  for (int& x : stl::view::stride(v, 2))
+    x = 0;
+  assert(v == (std::vector<int> {0, 2, 0, 4, 0, 6, 0}));
+}
+
+
+void
+test_join()
+{
+  std::vector<std::vector<int>> vv {{1, 2}, {}, {3}, {}, {}, {4, 5, 6}, {}};
+  auto j = stl::view::join(vv);
+  static_assert(stl::ForwardRange<decltype(j)>());
+  static_assert(stl::BoundedRange<decltype(j)>());
+  static_assert(stl::SegmentedIterator<stl::iterator_t<decltype(j)>>());
+  assert(to_vector(j) == (std::vector<int> {1, 2, 3, 4, 5, 6}));
+
+  // Segment-aware algorithms.
+  assert(*stl::find(j, 4) == 4);
+  assert(stl::find(j, 7) == j.end());
+  auto i = stl::find(j, 3);
+  assert(stl::find(i, j.end(), 2) == j.end());
+  assert(stl::find(j.begin(), i, 2) != i);
+  assert(stl::all_of(j, [](int x) { return x > 0; }));
+  assert(stl::any_of(j, [](int x) { return x == 5; }));
+  std::vector<int> out(6);
+  stl::copy(j, out.begin());
+  assert(out == (std::vector<int> {1, 2, 3, 4, 5, 6}));
+  std::vector<int> part(3);
+  stl::copy(stl::next(j.begin()), i, part.begin());
+  assert(part[0] == 2 && part[1] == 0);
+
+  // Writing through the join.
+  for (int& x : j)
+    x *= 10;
+  assert(vv[5][2] == 60);
+
+  // Lists of pages, and empty ranges.
+  std::list<std::vector<char>> pages {{'a', 'b'}, {'c'}};
+  std::string s;
+  for (char c : pages | stl::view::join)
+    s += c;
+  assert(s == "abc");
+  std::vector<std::vector<int>> e {{}, {}};
+  assert(stl::view::join(e).begin() == stl::view::join(e).end());
+}
+
+
+int main()
+{
+  test_transform();
+  test_filter();
+  test_take_drop();
+  test_while();
+  test_pipe();
+  test_bounded();
+  test_counted();
+  test_split();
+  test_zip();
+  test_enumerate();
+  test_chunk_stride();
+  test_join();
+}